@@ -1,28 +1,40 @@
 
 #include <iostream>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day01_part1 {
+
 /* There are definitely sexier approaches involving zips, but why mess with 
  * iteration. */
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
 
+    AOC_TRACE_NEXT_PHASE("solve");
     int last_height {};
-    std::cin >> last_height;
+    in >> last_height;
 
     int next_height {};
     int increases = 0;
-    /* std::istream converts to true if it has not yet failed. */
-    while (std::cin >> next_height) { // try to read an int, and perform one loop iteration if you succeeded.
+    /* aoc::Cursor (like std::istream) converts to true if it has not yet failed. */
+    while (in >> next_height) { // try to read an int, and perform one loop iteration if you succeeded.
         if (next_height > last_height)
             increases++;
 
         last_height = next_height;
     }
 
-    std::cout << increases << '\n';
-
-    return 0;
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(increases);
 }
 
 // On my mac, g++ is actually clang for some reason. g++-11 is g++
 // g++-11 -std=c++20 -Wall -Wextra -Werror -Wpedantic solution.cpp -o solution
-// ./solution < input.txt
\ No newline at end of file
+// ./solution < input.txt
+
+AOC_REGISTER_SOLVER(1, 1, "reference", solve);
+
+}
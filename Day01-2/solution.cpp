@@ -1,6 +1,11 @@
 
 #include <iostream>
-#include <fstream>
+
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day01_part2 {
 
 /*
  * Let k be the size of each sum (here k = 3)
@@ -12,17 +17,15 @@
 
 constexpr int K = 3;
 
-int main(int argc, char *argv[]) {
-    std::string file_name {"input.txt"};
-
-    if (argc >= 2) {
-        file_name = argv[1];
-    }
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
 
-    /* input_1 runs ahead, input_2 runs k behind. */
-    std::fstream input_1 = std::fstream(file_name);
-    std::fstream input_2 = std::fstream(file_name);
+    /* input_1 runs ahead, input_2 runs k behind. Both read the same mapped
+     * memory, so this no longer needs to open the file twice. */
+    aoc::Cursor input_1 {input};
+    aoc::Cursor input_2 {input};
 
+    AOC_TRACE_NEXT_PHASE("solve");
     /* Move input_1 ahead. */
     int last_sum {};
     for (int i {0}; i < K; i++) {
@@ -46,9 +49,12 @@ int main(int argc, char *argv[]) {
         last_sum = next_sum;
     }
 
-    std::cout << count << "\n";
-
-    return 0;
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(count);
 }
 
-// ./solution input.txt
\ No newline at end of file
+// ./solution input.txt (or ./solution < input.txt)
+
+AOC_REGISTER_SOLVER(1, 2, "reference", solve);
+
+}
@@ -1,6 +1,12 @@
 
 #include <iostream>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day02_part1 {
+
 /* Unfortunately, switches do not support strings directly, so we use an enum.
  * We get to take advantage of C++'s operator overload system. */
 
@@ -10,8 +16,8 @@ enum direction {
     UP
 };
 
-std::istream& operator>>(std::istream& in, direction& dir) {
-    std::string buffer {};
+aoc::Cursor& operator>>(aoc::Cursor& in, direction& dir) {
+    std::string_view buffer {};
     in >> buffer;
 
     if (buffer == "forward")
@@ -24,13 +30,18 @@ std::istream& operator>>(std::istream& in, direction& dir) {
     return in;
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
+
+    AOC_TRACE_NEXT_PHASE("solve");
     int x = {};
     int depth {};
     direction direction {};
-    while (std::cin >> direction) {
+    while (in >> direction) {
         int amount {};
-        std::cin >> amount;
+        in >> amount;
 
         switch (direction) {
         case FORWARD:
@@ -45,6 +56,10 @@ int main() {
         }
     }
 
-    std::cout << "x: " << x << " depth: " << depth << "\n";
-    std::cout << "answer: " << x * depth << "\n";
-}
\ No newline at end of file
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(x * depth);
+}
+
+AOC_REGISTER_SOLVER(2, 1, "reference", solve);
+
+}
@@ -1,14 +1,20 @@
 
 #include <iostream>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day02_part2 {
+
 enum direction {
     FORWARD,
     DOWN,
     UP
 };
 
-std::istream& operator>>(std::istream& in, direction& dir) {
-    std::string buffer {};
+aoc::Cursor& operator>>(aoc::Cursor& in, direction& dir) {
+    std::string_view buffer {};
     in >> buffer;
 
     if (buffer == "forward")
@@ -21,14 +27,19 @@ std::istream& operator>>(std::istream& in, direction& dir) {
     return in;
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
+
+    AOC_TRACE_NEXT_PHASE("solve");
     int x = {};
     int depth {};
     int aim {};
     direction direction {};
-    while (std::cin >> direction) {
+    while (in >> direction) {
         int amount {};
-        std::cin >> amount;
+        in >> amount;
 
         /* The only real changes were in these cases. */
         switch (direction) {
@@ -45,6 +56,10 @@ int main() {
         }
     }
 
-    std::cout << "x: " << x << " depth: " << depth << "\n";
-    std::cout << "answer: " << x * depth << "\n";
-}
\ No newline at end of file
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(x * depth);
+}
+
+AOC_REGISTER_SOLVER(2, 2, "reference", solve);
+
+}
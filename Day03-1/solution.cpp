@@ -5,17 +5,26 @@
 #include <iostream>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day03_part1 {
 
 constexpr int NUM_BITS = 12;
 
-int main() {
+std::string solve(std::string_view input_text) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input_text};
+
     std::vector<std::bitset<NUM_BITS>> input {};
 
-    std::bitset<NUM_BITS> next {};
-    while (std::cin >> next) {
-        input.push_back(next);
+    std::string_view next {};
+    while (in >> next) {
+        input.push_back(std::bitset<NUM_BITS>(next.data(), next.size()));
     }
     
+    AOC_TRACE_NEXT_PHASE("solve");
     std::array<int, NUM_BITS> ones_in_column {};
     std::for_each(input.begin(), input.end(), [&ones_in_column](const std::bitset<NUM_BITS>& current) {
         for (int i {0}; i < NUM_BITS; i++) {
@@ -28,9 +37,13 @@ int main() {
         most_common[i] = (unsigned) ones_in_column[i] > input.size() / 2;
     }
     
+    AOC_TRACE_NEXT_PHASE("output");
     int gamma_rate = (int) most_common.to_ulong();
     int epsilon_rate = (int) (~most_common).to_ulong();
 
-    std::cout << "gamma rate: " << gamma_rate << " epsilon rate: " << epsilon_rate << "\n";
-    std::cout << "power consumption: " << gamma_rate * epsilon_rate << "\n";
-}
\ No newline at end of file
+    return std::to_string(gamma_rate * epsilon_rate);
+}
+
+AOC_REGISTER_SOLVER(3, 1, "reference", solve);
+
+}
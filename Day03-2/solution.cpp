@@ -6,6 +6,11 @@
 #include <ranges>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day03_part2 {
 
 constexpr int NUM_BITS = 12;
 
@@ -41,19 +46,24 @@ std::bitset<NUM_BITS> find_line(const std::vector<std::bitset<NUM_BITS>>& input,
     return remaining[0];
 }
 
-int main() {
+std::string solve(std::string_view input_text) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input_text};
+
     std::vector<std::bitset<NUM_BITS>> input {};
 
-    std::bitset<NUM_BITS> next {};
-    while (std::cin >> next) {
-        input.push_back(next);
+    std::string_view next {};
+    while (in >> next) {
+        input.push_back(std::bitset<NUM_BITS>(next.data(), next.size()));
     }
 
+    AOC_TRACE_NEXT_PHASE("solve");
     std::bitset<NUM_BITS> oxygen = find_line(input, true);
-    std::cout << "Oxygen: " << oxygen << std::endl;
-
     std::bitset<NUM_BITS> CO2 = find_line(input, false);
-    std::cout << "CO2: " << CO2 << std::endl;
 
-    std::cout << "Answer: " << oxygen.to_ulong() * CO2.to_ullong()  << std::endl;
+    return std::to_string(oxygen.to_ulong() * CO2.to_ullong());
+}
+
+AOC_REGISTER_SOLVER(3, 2, "reference", solve);
+
 }
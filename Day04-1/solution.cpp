@@ -2,18 +2,22 @@
 #include <array>
 #include <cassert>
 #include <iostream>
-#include <sstream>
 #include <ranges>
 #include <unordered_map>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day04_part1 {
 
 class BingoBoard {
 public:
     static constexpr int WIDTH {5};
     static constexpr int HEIGHT {5};
 
-    friend std::istream& operator>>(std::istream& in, BingoBoard& board);
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, BingoBoard& board);
 
     /* Returns true one BINGO! */    
     bool update(int new_num) {
@@ -44,7 +48,7 @@ private:
     std::array<int, HEIGHT> row_counts {};
 };
 
-std::istream& operator>>(std::istream& in, BingoBoard& board) {
+aoc::Cursor& operator>>(aoc::Cursor& in, BingoBoard& board) {
     board = {}; // Reset the board variable!
 
     for (int x {0}; x < BingoBoard::WIDTH; x++) {
@@ -71,28 +75,33 @@ int run_bingo(const std::vector<int>& called_numbers, std::vector<BingoBoard>& b
     assert(false);
 }
 
-int main() {
-    std::string first_line {};
-    std::cin >> first_line;
-    std::istringstream sstream {first_line};
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
+    std::string_view first_line {};
+    in.getline(first_line);
+    aoc::Cursor line {first_line};
 
     std::vector<int> called_numbers {};
-    while (sstream) {
-        int num {};
-        sstream >> num;
+    int num {};
+    while (line >> num) {
         called_numbers.push_back(num);
 
         char _;
-        sstream >> _;
+        line >> _;
     }
     
     std::vector<BingoBoard> boards {};
     BingoBoard nextBoard {};
-    while (std::cin >> nextBoard) {
+    while (in >> nextBoard) {
         boards.push_back(nextBoard);
     }
 
-    std::cout << run_bingo(called_numbers, boards) << "\n";
+    AOC_TRACE_NEXT_PHASE("solve");
+    return std::to_string(run_bingo(called_numbers, boards));
+}
 
-    return 0;
-}
\ No newline at end of file
+AOC_REGISTER_SOLVER(4, 1, "reference", solve);
+
+}
@@ -3,6 +3,12 @@
 #include <map> // n.b. unordered_map would be algorithmically better, but cannot hash structs without us providing our own hash function
 #include <iostream>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day05_part1 {
+
 /* Let's learn how to make iterators! 
  * In C++20, concepts are used for iterators, so to make something iterable, we
  * simply give it begin() and end() functions. 
@@ -23,7 +29,7 @@ private:
     class Iterator;
 
 public:
-    friend std::istream& operator>>(std::istream& in, Line& line);
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, Line& line);
 
     bool isVerticalOrHorizontal() {
         return p1.x == p2.x || p1.y == p2.y;
@@ -92,7 +98,7 @@ private:
                 return {-1, 0};
             }
             
-            std::cout << "\n Error in get_step(): non horizontal or vertical lines not supported \n"; 
+            std::cerr << "\n Error in get_step(): non horizontal or vertical lines not supported \n"; 
             assert(false);
         }
 
@@ -104,10 +110,10 @@ private:
     };
 };
 
-std::istream& operator>>(std::istream& in, Line& line) {
+aoc::Cursor& operator>>(aoc::Cursor& in, Line& line) {
     line = {};
     char buffer_char {};
-    std::string buffer_string {};
+    std::string_view buffer_string {};
 
     in >> line.p1.x;
     in >> buffer_char; // ','
@@ -123,11 +129,15 @@ std::istream& operator>>(std::istream& in, Line& line) {
 }
 
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     std::map<std::pair<int, int>, int> map {};
 
+    AOC_TRACE_NEXT_PHASE("build");
     Line curr {};
-    while (std::cin >> curr) {
+    while (in >> curr) {
         if (!curr.isVerticalOrHorizontal())
             continue;
         for (Point2D p : curr) {
@@ -135,11 +145,17 @@ int main() {
         }
     }
 
+    AOC_TRACE_NEXT_PHASE("solve");
     int count {};
     for (auto [point, vents] : map) {
         if (vents > 1)
             count++;
     }
 
-    std::cout << count << std::endl;
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(count);
+}
+
+AOC_REGISTER_SOLVER(5, 1, "reference", solve);
+
 }
@@ -3,6 +3,12 @@
 #include <map> // n.b. unordered_map would be algorithmically better, but cannot hash structs without us providing our own hash function
 #include <iostream>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day05_part2 {
+
 /* Simply add support for iterators of diagonals, and stop ignoring them in the 
  * main function. */
 
@@ -26,7 +32,7 @@ private:
     class Iterator;
 
 public:
-    friend std::istream& operator>>(std::istream& in, Line& line);
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, Line& line);
 
     bool isVerticalOrHorizontal() {
         return p1.x == p2.x || p1.y == p2.y;
@@ -110,16 +116,16 @@ private:
                 return {-1, 1};
             }
             
-            std::cout << "\n Error in get_step(): We only support horizontal, vertical, or 45 degree diagonal lines \n"; 
+            std::cerr << "\n Error in get_step(): We only support horizontal, vertical, or 45 degree diagonal lines \n"; 
             assert(false);
         }
     };
 };
 
-std::istream& operator>>(std::istream& in, Line& line) {
+aoc::Cursor& operator>>(aoc::Cursor& in, Line& line) {
     line = {};
     char buffer_char {};
-    std::string buffer_string {};
+    std::string_view buffer_string {};
 
     in >> line.p1.x;
     in >> buffer_char; // ','
@@ -135,21 +141,31 @@ std::istream& operator>>(std::istream& in, Line& line) {
 }
 
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     std::map<std::pair<int, int>, int> map {};
 
+    AOC_TRACE_NEXT_PHASE("build");
     Line curr {};
-    while (std::cin >> curr) {
+    while (in >> curr) {
         for (Point2D p : curr) {
             map[std::pair(p.x, p.y)]++;
         }
     }
 
+    AOC_TRACE_NEXT_PHASE("solve");
     int count {};
     for (auto [point, vents] : map) {
         if (vents > 1)
             count++;
     }
 
-    std::cout << count << std::endl;
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(count);
+}
+
+AOC_REGISTER_SOLVER(5, 2, "reference", solve);
+
 }
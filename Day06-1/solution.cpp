@@ -11,6 +11,12 @@
 #include <array>
 #include <iostream>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day06_part1 {
+
 /* Returns the number shifted out the left side. */
 template<typename T, unsigned long NUM> 
 T shift_left(std::array<T, NUM>& arr) {
@@ -28,15 +34,19 @@ T shift_left(std::array<T, NUM>& arr) {
 
 constexpr int DAYS {80};
 
-int main() {
+std::string solve(std::string_view input_text) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input_text};
+
     std::array<long, 9> number_at_time {};
     long input {};
-    while (std::cin >> input) {
+    while (in >> input) {
         char _ {};
-        std::cin >> _; // ','
+        in >> _; // ','
         number_at_time[input]++;
     }
 
+    AOC_TRACE_NEXT_PHASE("solve");
     for (int i {0}; i < DAYS; i++) {
         long reproducing = shift_left(number_at_time);
         number_at_time[6] += reproducing;
@@ -48,5 +58,10 @@ int main() {
         sum += item;
     }
 
-    std::cout << "Total: " << sum << "\n";
-}
\ No newline at end of file
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(sum);
+}
+
+AOC_REGISTER_SOLVER(6, 1, "reference", solve);
+
+}
@@ -17,16 +17,26 @@
 #include <iostream>
 #include <vector>
 
-int main() {
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day07_part1 {
+
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     std::vector<int> positions {};
 
     int num {};
     char _;
-    while (std::cin >> num) {
+    while (in >> num) {
         positions.push_back(num);
-        std::cin >> _; // ','
+        in >> _; // ','
     }
 
+    AOC_TRACE_NEXT_PHASE("solve");
     std::sort(positions.begin(), positions.end());
     int median = positions[positions.size() / 2];
 
@@ -35,8 +45,10 @@ int main() {
         total_deviation += std::abs(median - pos);
     }
 
-    std::cout << "Fuel Cost: " << total_deviation << '\n';
-
-    return 0;
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(total_deviation);
 }
 
+AOC_REGISTER_SOLVER(7, 1, "reference", solve);
+
+}
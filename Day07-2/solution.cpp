@@ -21,37 +21,47 @@
 #include <unordered_map>
 #include <vector>
 
-/* Memoized for efficiency. */
-int fuel_cost(int distance) {
-    static std::unordered_map<int, int> cached_costs {{0, 0}}; // Careful: you need the base case here (0 -> 0)
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
 
+namespace day07_part2 {
+
+/* Memoized for efficiency. The cache belongs to the caller, so that solving
+ * several inputs at once is safe. */
+int fuel_cost(int distance, std::unordered_map<int, int>& cached_costs) {
     if (cached_costs.contains(distance)) {
         return cached_costs[distance];
     }
 
-    cached_costs[distance] = distance + fuel_cost(distance - 1);
+    cached_costs[distance] = distance + fuel_cost(distance - 1, cached_costs);
     return cached_costs[distance];
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     std::vector<int> positions {};
 
     int num {};
     char _;
-    while (std::cin >> num) {
+    while (in >> num) {
         positions.push_back(num);
-        std::cin >> _; // ','
+        in >> _; // ','
     }
 
+    AOC_TRACE_NEXT_PHASE("solve");
     std::sort(positions.begin(), positions.end());
     int lowest_pos {positions[0]};
     int highest_pos {positions[positions.size() - 1]};
 
+    std::unordered_map<int, int> cached_costs {{0, 0}}; // Careful: you need the base case here (0 -> 0)
     int best_deviation {INT32_MAX};
     for (int i {lowest_pos}; i <= highest_pos; i++) {
         int current_cost {};
         for (int pos : positions) {
-            current_cost += fuel_cost(std::abs(pos - i));
+            current_cost += fuel_cost(std::abs(pos - i), cached_costs);
         }
 
         if (current_cost > best_deviation)
@@ -60,8 +70,10 @@ int main() {
         best_deviation = current_cost;
     }
 
-    std::cout << "Fuel Cost: " << best_deviation << '\n';
-
-    return 0;
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(best_deviation);
 }
 
+AOC_REGISTER_SOLVER(7, 2, "reference", solve);
+
+}
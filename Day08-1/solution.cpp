@@ -1,27 +1,35 @@
 
 #include <algorithm>
 #include <iostream>
-#include <sstream>
 #include <unordered_map>
 #include <vector>
 
-/* Fill digits and to_decode with contents of line. Sort all strings. */
-void parse_line(std::string line, std::vector<std::string>& digits, std::vector<std::string>& to_decode) {
-    std::istringstream sstream {line};
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day08_part1 {
+
+/* Fill digits and to_decode with contents of line. Sort all strings. 
+ * (The strings are at most 7 characters, so they never leave the SSO buffer.) */
+void parse_line(std::string_view line, std::vector<std::string>& digits, std::vector<std::string>& to_decode) {
+    aoc::Cursor in {line};
 
     for (int i {0}; i < 10; i++) {
-        std::string digit {};
-        sstream >> digit;
+        std::string_view token {};
+        in >> token;
+        std::string digit {token};
         std::sort(digit.begin(), digit.end());
         digits.push_back(digit);
     }
 
-    std::string _;
-    sstream >> _; // | delimiter
+    std::string_view _;
+    in >> _; // | delimiter
     
     for (int i {0}; i < 4; i++) {
-        std::string digit {};
-        sstream >> digit;
+        std::string_view token {};
+        in >> token;
+        std::string digit {token};
         std::sort(digit.begin(), digit.end());
         to_decode.push_back(digit);
     }
@@ -69,13 +77,19 @@ std::vector<int> decode_with(const decoder_table& decoder, const std::vector<std
     return output;
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+
+    AOC_TRACE_NEXT_PHASE("solve");
     int total {0};
 
-    std::string line {};
-    while (std::getline(std::cin, line)) {
-        std::vector<std::string> digits {};
-        std::vector<std::string> to_decode {};
+    /* Reused between lines, so parsing does not allocate once they have grown. */
+    std::vector<std::string> digits {};
+    std::vector<std::string> to_decode {};
+
+    for (std::string_view line : aoc::lines(input)) {
+        digits.clear();
+        to_decode.clear();
         parse_line(line, digits, to_decode);
 
         decoder_table table {generate_decoder_table(digits)};
@@ -87,7 +101,10 @@ int main() {
         }
     }
 
-    std::cout << "Total: " << total << "\n";
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(total);
+}
+
+AOC_REGISTER_SOLVER(8, 1, "reference", solve);
 
-    return 0;
-}
\ No newline at end of file
+}
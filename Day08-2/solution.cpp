@@ -3,10 +3,15 @@
 #include <array>
 #include <cassert>
 #include <iostream>
-#include <sstream>
 #include <unordered_map>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day08_part2 {
+
 /* The key insight is that we have information on the total frequency of segments
  * across all 10 digits. If we count them all, they have mostly unique frequencies,
  * but 2 appear 8 times and 2 appear 7 times, so this is not yet perfect.
@@ -16,23 +21,26 @@
  * guess and check (and no drawn out logic). We don't even have to explicitely
  * track down 1 4 7 and 8 now, like we did in part 1. */
 
-/* Fill digits and to_decode with contents of line. Sort all strings. */
-void parse_line(std::string line, std::vector<std::string>& digits, std::vector<std::string>& to_decode) {
-    std::istringstream sstream {line};
+/* Fill digits and to_decode with contents of line. Sort all strings. 
+ * (The strings are at most 7 characters, so they never leave the SSO buffer.) */
+void parse_line(std::string_view line, std::vector<std::string>& digits, std::vector<std::string>& to_decode) {
+    aoc::Cursor in {line};
 
     for (int i {0}; i < 10; i++) {
-        std::string digit {};
-        sstream >> digit;
+        std::string_view token {};
+        in >> token;
+        std::string digit {token};
         std::sort(digit.begin(), digit.end());
         digits.push_back(digit);
     }
 
-    std::string _;
-    sstream >> _; // | delimiter
+    std::string_view _;
+    in >> _; // | delimiter
     
     for (int i {0}; i < 4; i++) {
-        std::string digit {};
-        sstream >> digit;
+        std::string_view token {};
+        in >> token;
+        std::string digit {token};
         std::sort(digit.begin(), digit.end());
         to_decode.push_back(digit);
     }
@@ -90,13 +98,19 @@ int decode_with(const decoder_table& decoder, const std::vector<std::string>& en
     return output;
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+
+    AOC_TRACE_NEXT_PHASE("solve");
     int total {0};
 
-    std::string line {};
-    while (std::getline(std::cin, line)) {
-        std::vector<std::string> digits {};
-        std::vector<std::string> to_decode {};
+    /* Reused between lines, so parsing does not allocate once they have grown. */
+    std::vector<std::string> digits {};
+    std::vector<std::string> to_decode {};
+
+    for (std::string_view line : aoc::lines(input)) {
+        digits.clear();
+        to_decode.clear();
         parse_line(line, digits, to_decode);
 
         decoder_table table {generate_decoder_table(digits)};
@@ -105,7 +119,10 @@ int main() {
         total += result;
     }
 
-    std::cout << "Total: " << total << "\n";
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(total);
+}
+
+AOC_REGISTER_SOLVER(8, 2, "reference", solve);
 
-    return 0;
-}
\ No newline at end of file
+}
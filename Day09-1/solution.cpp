@@ -1,9 +1,14 @@
 
 #include <array>
 #include <iostream>
-#include <sstream>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day09_part1 {
+
 class HeightMap {
 private:
     std::vector<std::vector<int>> matrix {};
@@ -60,22 +65,29 @@ public:
     }
 };
 
-int main() {
-    std::string buffer {};
+std::string solve(std::string_view input_text) {
+    AOC_TRACE_PHASES("parse");
+
     std::vector<std::vector<int>> input {};
-    while (std::getline(std::cin, buffer)) {
+    for (std::string_view line : aoc::lines(input_text)) {
         
         std::vector<int> curr_row {};
-        std::istringstream sstream {buffer};
+        curr_row.reserve(line.size());
 
-        char digit {};
-        while (sstream >> digit) {
-            curr_row.push_back(std::stoi(std::string {digit}));
+        for (char digit : line) {
+            if (!aoc::is_space(digit))
+                curr_row.push_back(digit - '0');
         }
 
-        input.push_back(curr_row);
+        input.push_back(std::move(curr_row));
     }
 
+    AOC_TRACE_NEXT_PHASE("build");
     HeightMap height_map {input};
-    std::cout << height_map.sum_risk_level() << '\n';
-}
\ No newline at end of file
+    AOC_TRACE_NEXT_PHASE("solve");
+    return std::to_string(height_map.sum_risk_level());
+}
+
+AOC_REGISTER_SOLVER(9, 1, "reference", solve);
+
+}
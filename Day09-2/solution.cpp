@@ -3,9 +3,14 @@
 #include <array>
 #include <iostream>
 #include <set>
-#include <sstream>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day09_part2 {
+
 /* Importantly, all basins correspond to a single low point. We can generate the 
  * low points, as before, and the try to expand them out into basins. Since all
  * low points have a basin, we can simply include all non-9 squares (instead of
@@ -107,24 +112,32 @@ public:
 
 };
 
-int main() {
-    std::string buffer {};
+std::string solve(std::string_view input_text) {
+    AOC_TRACE_PHASES("parse");
+
     std::vector<std::vector<int>> input {};
-    while (std::getline(std::cin, buffer)) {
+    for (std::string_view line : aoc::lines(input_text)) {
         
         std::vector<int> curr_row {};
-        std::istringstream sstream {buffer};
+        curr_row.reserve(line.size());
 
-        char digit {};
-        while (sstream >> digit) {
-            curr_row.push_back(std::stoi(std::string {digit}));
+        for (char digit : line) {
+            if (!aoc::is_space(digit))
+                curr_row.push_back(digit - '0');
         }
 
-        input.push_back(curr_row);
+        input.push_back(std::move(curr_row));
     }
 
+    AOC_TRACE_NEXT_PHASE("build");
     HeightMap height_map {input};
+    AOC_TRACE_NEXT_PHASE("solve");
     std::vector<int> basin_sizes {height_map.get_basin_sizes()};
     std::sort(basin_sizes.rbegin(), basin_sizes.rend()); // Largest to smallest (reverse of normal)
-    std::cout << "Answer: " << basin_sizes[0] * basin_sizes[1] * basin_sizes[2] << '\n';
-}
\ No newline at end of file
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(basin_sizes[0] * basin_sizes[1] * basin_sizes[2]);
+}
+
+AOC_REGISTER_SOLVER(9, 2, "reference", solve);
+
+}
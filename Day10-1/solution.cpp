@@ -4,6 +4,12 @@
 #include <map>
 #include <stack>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day10_part1 {
+
 /* The trick is to use a stack. */
 
 struct ErrorInfo {
@@ -22,7 +28,7 @@ bool left_right_match(char left, char right) {
     }
 }
 
-ErrorInfo parse_line(const std::string& line) {
+ErrorInfo parse_line(std::string_view line) {
     std::stack<char> open_chunks {};
 
     for (char ch : line) {
@@ -63,17 +69,24 @@ const std::map<char, int> scores {
     {'>', 25137}
 };
 
-int main() {
-    std::string line {};
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    std::string_view line {};
     int total_score {};
-    while (std::cin >> line) {
+    while (in >> line) {
         ErrorInfo e {parse_line(line)};
         if (e.error_type == ErrorInfo::CORRUPTED) {
             total_score += scores.at(e.offending_char);
         }
     }
 
-    std::cout << "Total Score: " << total_score << '\n';
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(total_score);
+}
+
+AOC_REGISTER_SOLVER(10, 1, "reference", solve);
 
-    return 0;
-}
\ No newline at end of file
+}
@@ -4,8 +4,14 @@
 #include <iostream>
 #include <map>
 #include <stack>
+
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
 #include <vector>
 
+namespace day10_part2 {
+
 /* The trick is to use a stack. */
 
 /* This error type is a little hacky, since only the offending_char or the completion_string
@@ -28,7 +34,7 @@ char left_to_right(char left) {
     }
 }
 
-ErrorInfo parse_line(const std::string& line) {
+ErrorInfo parse_line(std::string_view line) {
     std::stack<char> open_chunks {};
 
     for (char ch : line) {
@@ -79,11 +85,15 @@ const std::map<char, int> char_scores {
     {'>', 4}
 };
 
-int main() {
-    std::string line {};
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    std::string_view line {};
     std::vector<long> scores {}; // Another gotcha with needing a longs instead of ints.
 
-    while (std::cin >> line) {
+    while (in >> line) {
         ErrorInfo e {parse_line(line)};
         if (e.error_type == ErrorInfo::INCOMPLETE) {
             long score {0};
@@ -96,7 +106,10 @@ int main() {
     }
 
     std::sort(scores.begin(), scores.end());
-    std::cout << "Middle Score: " << scores[scores.size() / 2] << '\n';
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(scores[scores.size() / 2]);
+}
+
+AOC_REGISTER_SOLVER(10, 2, "reference", solve);
 
-    return 0;
-}
\ No newline at end of file
+}
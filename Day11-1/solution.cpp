@@ -2,6 +2,11 @@
 #include <array>
 #include <iostream>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day11_part1 {
 
 class SquidGrid {
 private:
@@ -36,7 +41,7 @@ private:
     }
 
 public:
-    friend std::istream& operator>>(std::istream& in, SquidGrid& grid);
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, SquidGrid& grid);
 
     int get_total_flashes() { return total_flashes; }
 
@@ -55,7 +60,7 @@ public:
     }
 };
 
-std::istream& operator>>(std::istream& in, SquidGrid& grid) {
+aoc::Cursor& operator>>(aoc::Cursor& in, SquidGrid& grid) {
     grid = {};
 
     char buf {};
@@ -69,15 +74,22 @@ std::istream& operator>>(std::istream& in, SquidGrid& grid) {
     return in;
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     SquidGrid sg {};
-    std::cin >> sg;
+    in >> sg;
 
+    AOC_TRACE_NEXT_PHASE("solve");
     for (int i {0}; i < 100; i++) {
         sg.step();
     }
 
-    std::cout << "Flashes: " << sg.get_total_flashes() << '\n';
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(sg.get_total_flashes());
+}
+
+AOC_REGISTER_SOLVER(11, 1, "reference", solve);
 
-    return 0;
 }
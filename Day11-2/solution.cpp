@@ -2,6 +2,11 @@
 #include <array>
 #include <iostream>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day11_part2 {
 
 class SquidGrid {
 public:
@@ -38,7 +43,7 @@ private:
     }
 
 public:
-    friend std::istream& operator>>(std::istream& in, SquidGrid& grid);
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, SquidGrid& grid);
 
     int get_total_flashes() { return total_flashes; }
 
@@ -57,7 +62,7 @@ public:
     }
 };
 
-std::istream& operator>>(std::istream& in, SquidGrid& grid) {
+aoc::Cursor& operator>>(aoc::Cursor& in, SquidGrid& grid) {
     grid = {};
 
     char buf {};
@@ -72,10 +77,14 @@ std::istream& operator>>(std::istream& in, SquidGrid& grid) {
 }
 
 /* The only changes are down here! */
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     SquidGrid sg {};
-    std::cin >> sg;
+    in >> sg;
 
+    AOC_TRACE_NEXT_PHASE("solve");
     int steps {0};
     while (true) {
         steps++;
@@ -85,7 +94,10 @@ int main() {
             break;
     }
 
-    std::cout << "Steps until synchronized: " << steps << '\n';
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(steps);
+}
+
+AOC_REGISTER_SOLVER(11, 2, "reference", solve);
 
-    return 0;
 }
@@ -5,6 +5,11 @@
 #include <unordered_set>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day12_part2 {
 
 class CaveGraph {
 private:
@@ -66,16 +71,22 @@ public:
     }
 };
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     CaveGraph graph {};
 
-    std::string line {};
-    while (std::cin >> line) {
+    std::string_view line {};
+    while (in >> line) {
         int dash_index {static_cast<int>(line.find('-'))};
-        graph.add_edge(line.substr(0, dash_index), line.substr(dash_index + 1));
+        graph.add_edge(std::string {line.substr(0, dash_index)}, std::string {line.substr(dash_index + 1)});
     }
 
-    std::cout << graph.count_paths() << '\n';
+    AOC_TRACE_NEXT_PHASE("solve");
+    return std::to_string(graph.count_paths());
+}
+
+AOC_REGISTER_SOLVER(12, 2, "reference", solve);
 
-    return 0;
-}
\ No newline at end of file
+}
@@ -2,9 +2,13 @@
 #include <cassert>
 #include <iostream>
 #include <set>
-#include <sstream>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day13_part1 {
 
 /* I feel like this definitely is not asymptotically ideal, but with such small
  * input I don't think it really matters. */
@@ -35,20 +39,23 @@ void run_folds(std::set<std::pair<int, int>>& points, const std::vector<std::pai
     }
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     std::set<std::pair<int, int>> points {};
 
     while (true) {
-        std::string buffer {};
-        std::getline(std::cin, buffer);
-        std::istringstream line {buffer};
+        std::string_view buffer {};
+        in.getline(buffer);
+        aoc::Cursor line {buffer};
         if (buffer == "")
             break;
        
-        std::getline(line, buffer, ',');
-        int i {std::stoi(buffer)};
-        std::getline(line, buffer);
-        int j {std::stoi(buffer)};
+        int i {};
+        int j {};
+        char _ {};
+        line >> i >> _ >> j; // i,j
 
         points.insert({i, j});
     } 
@@ -56,21 +63,24 @@ int main() {
     std::vector<std::pair<char, int>> fold_instructions {};
     
     while (true) {
-        std::string buffer {};
-        std::getline(std::cin, buffer);
-        std::istringstream line {buffer};
+        std::string_view buffer {};
+        in.getline(buffer);
+        aoc::Cursor line {buffer};
         if (buffer == "")
             break;
         
         line >> buffer >> buffer >> buffer; // Buffer gets last important part
 
-        fold_instructions.push_back({buffer[0], std::stoi(buffer.substr(2))});    
+        fold_instructions.push_back({buffer[0], aoc::to_int<int>(buffer.substr(2))});    
     }
 
-    std::cout << "Points before fold: " << points.size() << '\n';
-
+    AOC_TRACE_NEXT_PHASE("solve");
     std::vector<std::pair<char, int>> single_instruction {fold_instructions[0]};
     run_folds(points, single_instruction);
 
-    std::cout << "Points after fold: " << points.size() << '\n';
+    return std::to_string(points.size());
+}
+
+AOC_REGISTER_SOLVER(13, 1, "reference", solve);
+
 }
@@ -2,9 +2,14 @@
 #include <cassert>
 #include <iostream>
 #include <set>
-#include <sstream>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day13_part2 {
+
 void run_folds(std::set<std::pair<int, int>>& points, const std::vector<std::pair<char, int>>& instructions) {
     for (auto [ch, num] : instructions) {
         std::set<std::pair<int, int>> next_points {}; // We cannot erase and iterate at once.
@@ -32,20 +37,23 @@ void run_folds(std::set<std::pair<int, int>>& points, const std::vector<std::pai
     }
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     std::set<std::pair<int, int>> points {};
 
     while (true) {
-        std::string buffer {};
-        std::getline(std::cin, buffer);
-        std::istringstream line {buffer};
+        std::string_view buffer {};
+        in.getline(buffer);
+        aoc::Cursor line {buffer};
         if (buffer == "")
             break;
        
-        std::getline(line, buffer, ',');
-        int i {std::stoi(buffer)};
-        std::getline(line, buffer);
-        int j {std::stoi(buffer)};
+        int i {};
+        int j {};
+        char _ {};
+        line >> i >> _ >> j; // i,j
 
         points.insert({i, j});
     } 
@@ -53,19 +61,21 @@ int main() {
     std::vector<std::pair<char, int>> fold_instructions {};
     
     while (true) {
-        std::string buffer {};
-        std::getline(std::cin, buffer);
-        std::istringstream line {buffer};
+        std::string_view buffer {};
+        in.getline(buffer);
+        aoc::Cursor line {buffer};
         if (buffer == "")
             break;
         
         line >> buffer >> buffer >> buffer; // Buffer gets last important part
 
-        fold_instructions.push_back({buffer[0], std::stoi(buffer.substr(2))});    
+        fold_instructions.push_back({buffer[0], aoc::to_int<int>(buffer.substr(2))});    
     }
 
+    AOC_TRACE_NEXT_PHASE("solve");
     run_folds(points, fold_instructions);
     
+    AOC_TRACE_NEXT_PHASE("output");
     int max_x {0};
     int max_y {0};
 
@@ -76,10 +86,18 @@ int main() {
             max_y = y;
     }
 
+    /* The answer is whatever letters these spell out. */
+    std::string picture {};
     for (int row {0}; row < max_y + 1; row++) {
         for (int col {0}; col < max_x + 1; col++) {
-            std::cout << (points.contains({col, row}) ? "⬜" : "⬛");
+            picture += (points.contains({col, row}) ? "⬜" : "⬛");
         }
-        std::cout << '\n';
+        if (row < max_y)
+            picture += '\n';
     }
+    return picture;
+}
+
+AOC_REGISTER_SOLVER(13, 2, "reference", solve);
+
 }
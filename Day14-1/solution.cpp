@@ -4,6 +4,12 @@
 #include <map>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day14_part1 {
+
 /* You can already see that this problem explodes exponentially with time:
  * each step has the potential to introduce a number of new nodes that is almost
  * equal to the number of nodes in the last step.
@@ -25,19 +31,23 @@ void substitute_n_times(std::vector<char>& vec, const std::map<std::pair<char, c
     }
 }
 
-int main() {
-    std::string input {};
-    std::cin >> input;
+std::string solve(std::string_view input_text) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input_text};
+
+    std::string_view input {};
+    in >> input;
     std::vector<char> input_vector(input.begin(), input.end());
 
     std::map<std::pair<char, char>, char> rules {};
-    std::string left {};
-    std::string arrow {};
-    std::string right {};
-    while (std::cin >> left >> arrow >> right) {
+    std::string_view left {};
+    std::string_view arrow {};
+    std::string_view right {};
+    while (in >> left >> arrow >> right) {
         rules[{left[0], left[1]}] = right[0];
     }
 
+    AOC_TRACE_NEXT_PHASE("solve");
     substitute_n_times(input_vector, rules, 10);
 
     std::map<char, int> counts {};
@@ -52,5 +62,10 @@ int main() {
 
     std::sort(counts_vector.begin(), counts_vector.end());
 
-    std::cout << counts_vector.back() - counts_vector[0] << '\n';
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(counts_vector.back() - counts_vector[0]);
+}
+
+AOC_REGISTER_SOLVER(14, 1, "reference", solve);
+
 }
@@ -5,6 +5,12 @@
 #include <numeric>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day14_part2 {
+
 /* As predicted, this problem is exponential, and cannot be solved by brute force.
  * Essentially, we know we have to change the output, because a string with an
  * exponential number of characters is going to at least take an exponential 
@@ -29,15 +35,16 @@ std::map<char, long> add_maps(std::map<char, long> m1, const std::map<char, long
     return m1; // Returns a copy, don't worry, neither original has changed.
 }
 
-/* It's global, but thats fine for now. */
-std::map<std::pair<std::pair<char, char>, int>, std::map<char, long>> memoization_table {};
+/* Only valid for one set of rules, so each solve() makes its own. */
+using MemoizationTable = std::map<std::pair<std::pair<char, char>, int>, std::map<char, long>>;
 
 /* Returns the number of each character that is inserted between `chars` in `n` steps,
  * according to `rules` */
 std::map<char, long> get_counts_between(
         const std::pair<char, char> chars, 
         const std::map<std::pair<char, char>, char>& rules, 
-        int n) {
+        int n,
+        MemoizationTable& memoization_table) {
 
     /* Base Case: n = 0, or no insertion rule. */
     if (n == 0 || !rules.contains(chars)) {
@@ -52,8 +59,8 @@ std::map<char, long> get_counts_between(
     auto [left, right] {chars};
     char inserted {rules.at(chars)};
 
-    std::map<char, long> m1 {get_counts_between({left, inserted}, rules, n - 1)};
-    std::map<char, long> m2 {get_counts_between({inserted, right}, rules, n - 1)};
+    std::map<char, long> m1 {get_counts_between({left, inserted}, rules, n - 1, memoization_table)};
+    std::map<char, long> m2 {get_counts_between({inserted, right}, rules, n - 1, memoization_table)};
     std::map<char, long> m_final {add_maps(m1, m2)};
     m_final[inserted]++;
 
@@ -62,27 +69,32 @@ std::map<char, long> get_counts_between(
     return m_final;
 }
 
-int main() {
-    std::string input {};
-    std::cin >> input;
+std::string solve(std::string_view input_text) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input_text};
+
+    std::string_view input {};
+    in >> input;
     std::vector<char> input_vector(input.begin(), input.end());
 
     std::map<std::pair<char, char>, char> rules {};
-    std::string left {};
-    std::string arrow {};
-    std::string right {};
-    while (std::cin >> left >> arrow >> right) {
+    std::string_view left {};
+    std::string_view arrow {};
+    std::string_view right {};
+    while (in >> left >> arrow >> right) {
         rules[{left[0], left[1]}] = right[0];
     }
 
+    AOC_TRACE_NEXT_PHASE("solve");
     /* Just to start, counts needs to contain info from original string. */
     std::map<char, long> counts {};
     for (char c : input_vector) {
         counts[c]++;
     }
 
+    MemoizationTable memoization_table {};
     for (int i {1}; i < static_cast<int>(input_vector.size()); i++) {
-        counts = add_maps(counts, get_counts_between({input_vector[i - 1], input_vector[i]}, rules, 40));
+        counts = add_maps(counts, get_counts_between({input_vector[i - 1], input_vector[i]}, rules, 40, memoization_table));
     }
 
     std::vector<long> counts_vector {};
@@ -92,5 +104,10 @@ int main() {
 
     std::sort(counts_vector.begin(), counts_vector.end());
 
-    std::cout << counts_vector.back() - counts_vector[0] << '\n';
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(counts_vector.back() - counts_vector[0]);
+}
+
+AOC_REGISTER_SOLVER(14, 2, "reference", solve);
+
 }
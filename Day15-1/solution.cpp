@@ -5,6 +5,12 @@
 #include <map>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day15_part1 {
+
 /* Essentially Dijkstra's Algorithm, except the weight of an edge is the amount
  * stored in the node. NOTE: since the edges of bidirectional, the weight cannot
  * be two numbers, so in reality we treat the weight as the value in the node of
@@ -42,6 +48,7 @@ int best_path_risk(const std::vector<std::vector<int>>& risk_levels) {
             continue;
 
         known_risks[pair] = risk;
+        AOC_TRACE_ADD("nodes_settled", 1);
         
         for (auto [dr, dc] : adjacent) {
             int r {pair.first + dr};
@@ -59,15 +66,23 @@ int best_path_risk(const std::vector<std::vector<int>>& risk_levels) {
     return known_risks[{size - 1, size - 1}];
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     std::vector<std::vector<int>> risk_levels {};
-    std::string buffer {};
-    while (std::cin >> buffer) {
+    std::string_view buffer {};
+    while (in >> buffer) {
         risk_levels.push_back({});
         for (char c : buffer) {
             risk_levels.back().push_back(c - '0');
         }
     }
 
-    std::cout << best_path_risk(risk_levels) << '\n';
-}
\ No newline at end of file
+    AOC_TRACE_NEXT_PHASE("solve");
+    return std::to_string(best_path_risk(risk_levels));
+}
+
+AOC_REGISTER_SOLVER(15, 1, "reference", solve);
+
+}
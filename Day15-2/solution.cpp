@@ -5,6 +5,10 @@
 #include <unordered_map> // Using this instead of <map> now
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
 /* The only change involves setting up the array. The previous algorithm was strong
  * enough to survive a 25 fold increase in elements. However, I wanted to see if
  * I could improve the algorithm my using a hashtable instead of a tree, which
@@ -31,6 +35,8 @@ struct std::hash<std::pair<int, int>> {
     }
 };
 
+namespace day15_part2 {
+
 int best_path_risk(const std::vector<std::vector<int>>& risk_levels) {
     int size {static_cast<int>(risk_levels.size())}; // The shape is a square.
 
@@ -53,6 +59,7 @@ int best_path_risk(const std::vector<std::vector<int>>& risk_levels) {
             continue;
 
         known_risks[pair] = risk;
+        AOC_TRACE_ADD("nodes_settled", 1);
         
         for (auto [dr, dc] : adjacent) {
             int r {pair.first + dr};
@@ -70,16 +77,20 @@ int best_path_risk(const std::vector<std::vector<int>>& risk_levels) {
     return known_risks[{size - 1, size - 1}];
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     std::vector<std::vector<int>> tile {};
-    std::string buffer {};
-    while (std::cin >> buffer) {
+    std::string_view buffer {};
+    while (in >> buffer) {
         tile.push_back({});
         for (char c : buffer) {
             tile.back().push_back(c - '0');
         }
     }
 
+    AOC_TRACE_NEXT_PHASE("build");
     const int tile_size {static_cast<int>(tile.size())}; 
     
     /* Construct a large and empty array first. */
@@ -101,5 +112,10 @@ int main() {
         }
     }
 
-    std::cout << best_path_risk(risk_levels) << '\n';
-}
\ No newline at end of file
+    AOC_TRACE_NEXT_PHASE("solve");
+    return std::to_string(best_path_risk(risk_levels));
+}
+
+AOC_REGISTER_SOLVER(15, 2, "reference", solve);
+
+}
@@ -5,6 +5,12 @@
 #include <variant>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day16_part1 {
+
 struct Packet {
 public:
     enum class Type {
@@ -24,7 +30,7 @@ private:
     int index;
 
 public:
-    Parser(const std::string& hexadecimal) : 
+    Parser(std::string_view hexadecimal) : 
         bits {from_hex(hexadecimal)}, index {0} 
     {}
 
@@ -89,7 +95,7 @@ private:
         packet.payload = subpackets;
     }
 
-    static std::vector<bool> from_hex(const std::string& hexadecimal) {
+    static std::vector<bool> from_hex(std::string_view hexadecimal) {
         static const std::map<char, std::array<bool, 4>> hex_map {
             {'0', {0, 0, 0, 0}},
             {'1', {0, 0, 0, 1}},
@@ -143,12 +149,19 @@ int version_sum(const Packet& packet) {
     return sum;
 }
 
-int main() {
-    std::string hex {};
-    std::cin >> hex;
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
+    std::string_view hex {};
+    in >> hex;
 
     Packet packet = Parser {hex}.parse_packet();
 
-    std::cout << version_sum(packet) << '\n';
-    return 0;
+    AOC_TRACE_NEXT_PHASE("solve");
+    return std::to_string(version_sum(packet));
+}
+
+AOC_REGISTER_SOLVER(16, 1, "reference", solve);
+
 }
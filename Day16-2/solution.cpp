@@ -7,6 +7,12 @@
 #include <variant>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day16_part2 {
+
 /* Once again, you have to use a long to fit the number we create. */
 
 struct Packet {
@@ -80,7 +86,7 @@ private:
     int index;
 
 public:
-    Parser(const std::string& hexadecimal) : 
+    Parser(std::string_view hexadecimal) : 
         bits {from_hex(hexadecimal)}, index {0} 
     {}
 
@@ -139,7 +145,7 @@ private:
         packet.payload = subpackets;
     }
 
-    static std::vector<bool> from_hex(const std::string& hexadecimal) {
+    static std::vector<bool> from_hex(std::string_view hexadecimal) {
         static const std::map<char, std::array<bool, 4>> hex_map {
             {'0', {0, 0, 0, 0}},
             {'1', {0, 0, 0, 1}},
@@ -181,12 +187,19 @@ private:
     }
 };
 
-int main() {
-    std::string hex {};
-    std::cin >> hex;
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
+    std::string_view hex {};
+    in >> hex;
 
     Packet packet = Parser {hex}.parse_packet();
 
-    std::cout << packet.evaluate() << '\n';
-    return 0;
+    AOC_TRACE_NEXT_PHASE("solve");
+    return std::to_string(packet.evaluate());
+}
+
+AOC_REGISTER_SOLVER(16, 2, "reference", solve);
+
 }
@@ -27,14 +27,47 @@
  * 
  * How high does the probe go with vy0 = 106? That is simply the 106th triangular
  * number
+ *
+ * (The target is now read from the input, so in general vy0 = |y_min| - 1.)
  */
 
+#include <array>
+#include <cstdlib>
 #include <iostream>
 
-int main() {
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day17_part1 {
+
+/* Returns {x_min, x_max, y_min, y_max}. */
+std::array<int, 4> parse_target(aoc::Cursor& in) {
+    std::array<int, 4> target_range {};
+    in.expect("target area: x=") >> target_range[0];
+    in.expect("..") >> target_range[1];
+    in.expect(", y=") >> target_range[2];
+    in.expect("..") >> target_range[3];
+
+    return target_range;
+}
+
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+    std::array<int, 4> target_range {parse_target(in)};
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    int vy0 {std::abs(target_range[2]) - 1};
+
     int sum {};
-    for (int i {1}; i <= 106; i++)
+    for (int i {1}; i <= vy0; i++)
         sum += i;
 
-    std::cout << sum << '\n';
-}
\ No newline at end of file
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(sum);
+}
+
+AOC_REGISTER_SOLVER(17, 1, "reference", solve);
+
+}
@@ -33,17 +33,32 @@
  * both axes for all combinations of x and y from (vx0_min to vx0_max) and (vy0_min to vy0_max).
  */
 
-/* That being said, if the naive approach works, lets just do that. I am also
- * too lazy to parse tonight, so I'll just use some arrays or something. */
+/* That being said, if the naive approach works, lets just do that. I was also
+ * too lazy to parse that night, so this used to hardcode the target as an array.
+ * It is read from the input now: "target area: x=230..283, y=-107..-57". */
 
 #include <array>
 #include <cmath>
 #include <iostream>
 
-constexpr std::array<int, 4> target_range {230, 283, -107, -57}; // input
-// constexpr std::array<int, 4> target_range {20, 30, -10, -5}; // sample
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
 
-bool simulate(int vx, int vy, int t_steps) {
+namespace day17_part2 {
+
+/* Returns {x_min, x_max, y_min, y_max}. */
+std::array<int, 4> parse_target(aoc::Cursor& in) {
+    std::array<int, 4> target_range {};
+    in.expect("target area: x=") >> target_range[0];
+    in.expect("..") >> target_range[1];
+    in.expect(", y=") >> target_range[2];
+    in.expect("..") >> target_range[3];
+
+    return target_range;
+}
+
+bool simulate(const std::array<int, 4>& target_range, int vx, int vy, int t_steps) {
     int x {0};
     int y {0};
     for (int i {0}; i < t_steps; i++) {
@@ -59,7 +74,12 @@ bool simulate(int vx, int vy, int t_steps) {
     return false;
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+    const std::array<int, 4> target_range {parse_target(in)};
+
+    AOC_TRACE_NEXT_PHASE("solve");
     int x_max {target_range[1]};
     int x_min {0};
     int x_stop_min {0};  // Where x reaches 0 for x_min;
@@ -77,12 +97,15 @@ int main() {
     
     for (int x {x_min}; x <= x_max; x++) {
         for (int y {y_min}; y <= y_max; y++) {
-            if (simulate(x, y, t_max))
+            if (simulate(target_range, x, y, t_max))
                 count++;
         }
     }
 
-    std::cout << count << '\n';
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(count);
+}
+
+AOC_REGISTER_SOLVER(17, 2, "reference", solve);
 
-    return 0;
 }
@@ -4,6 +4,12 @@
 #include <memory>
 #include <variant>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day18_part1 {
+
 class SnailfishNumber;
 
 struct BranchNode {
@@ -144,7 +150,7 @@ private:
     }
 
 public:
-    friend std::istream& operator>>(std::istream& in, SnailfishNumber& num);
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, SnailfishNumber& num);
 
     static SnailfishNumber* append(SnailfishNumber* l, SnailfishNumber* r) {
         SnailfishNumber* result = new SnailfishNumber();
@@ -186,7 +192,7 @@ public:
     }
 };
 
-std::istream& operator>>(std::istream& in, SnailfishNumber& num) {
+aoc::Cursor& operator>>(aoc::Cursor& in, SnailfishNumber& num) {
     num.parent = nullptr;
     num.position = SnailfishNumber::Position::Root;
 
@@ -199,7 +205,7 @@ std::istream& operator>>(std::istream& in, SnailfishNumber& num) {
     }
 
     if (buf != '[') {
-        in.setstate(std::ios::failbit);
+        in.set_fail();
         return in;
     }
     num.node = BranchNode {};
@@ -207,12 +213,12 @@ std::istream& operator>>(std::istream& in, SnailfishNumber& num) {
     std::get<BranchNode>(num.node).right = new SnailfishNumber();
     in >> *std::get<BranchNode>(num.node).left >> buf >> *std::get<BranchNode>(num.node).right;
     if (buf != ',' || in.fail()) {
-        in.setstate(std::ios::failbit);
+        in.set_fail();
         return in;
     }
     in >> buf;
     if (buf != ']') {
-        in.setstate(std::ios::failbit);
+        in.set_fail();
         return in;
     }
 
@@ -230,17 +236,24 @@ std::istream& operator>>(std::istream& in, SnailfishNumber& num) {
  * Edit: After submission, I did go back and plug the memory leak (at least the
  * major one.) */
 
-int main() {  
+std::string solve(std::string_view input) {  
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     SnailfishNumber* n = new SnailfishNumber();
-    std::cin >> *n;
+    in >> *n;
     
+    AOC_TRACE_NEXT_PHASE("solve");
     SnailfishNumber* next = new SnailfishNumber();
-    while (std::cin >> *next) {
+    while (in >> *next) {
         n = SnailfishNumber::append(n, next);
         next = new SnailfishNumber();
     }
 
-    std::cout << n->magnitude() << '\n';
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(n->magnitude());
+}
+
+AOC_REGISTER_SOLVER(18, 1, "reference", solve);
 
-    return 0;
 }
@@ -2,10 +2,15 @@
 #include <cassert>
 #include <iostream>
 #include <memory>
-#include <sstream>
 #include <variant>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day18_part2 {
+
 class SnailfishNumber;
 
 struct BranchNode {
@@ -157,7 +162,7 @@ public:
         }
     } 
 
-    friend std::istream& operator>>(std::istream& in, SnailfishNumber& num);
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, SnailfishNumber& num);
 
     static std::unique_ptr<SnailfishNumber> append(SnailfishNumber&& l, SnailfishNumber&& r) {
         std::unique_ptr<SnailfishNumber> result {std::make_unique<SnailfishNumber>()};
@@ -199,7 +204,7 @@ public:
     }
 };
 
-std::istream& operator>>(std::istream& in, SnailfishNumber& num) {
+aoc::Cursor& operator>>(aoc::Cursor& in, SnailfishNumber& num) {
     num.parent = nullptr;
     num.position = SnailfishNumber::Position::Root;
 
@@ -212,7 +217,7 @@ std::istream& operator>>(std::istream& in, SnailfishNumber& num) {
     }
 
     if (buf != '[') {
-        in.setstate(std::ios::failbit);
+        in.set_fail();
         return in;
     }
     num.node = BranchNode {};
@@ -220,12 +225,12 @@ std::istream& operator>>(std::istream& in, SnailfishNumber& num) {
     std::get<BranchNode>(num.node).right = std::make_unique<SnailfishNumber>();
     in >> *std::get<BranchNode>(num.node).left >> buf >> *std::get<BranchNode>(num.node).right;
     if (buf != ',' || in.fail()) {
-        in.setstate(std::ios::failbit);
+        in.set_fail();
         return in;
     }
     in >> buf;
     if (buf != ']') {
-        in.setstate(std::ios::failbit);
+        in.set_fail();
         return in;
     }
 
@@ -239,14 +244,19 @@ std::istream& operator>>(std::istream& in, SnailfishNumber& num) {
 
 /* After my first attempt, I made this even more memory safe by using unique pointers. */
 
-int main() {  
-    std::vector<std::string> inputs {};
+std::string solve(std::string_view input) {  
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
+    /* Views into the mapped input; each pair below re-parses straight from them. */
+    std::vector<std::string_view> inputs {};
 
-    std::string line {};
-    while (std::cin >> line) {
+    std::string_view line {};
+    while (in >> line) {
         inputs.push_back(line);
     }
 
+    AOC_TRACE_NEXT_PHASE("solve");
     int best_magnitude {0};
     for (int i {0}; i < static_cast<int>(inputs.size()); i++) {
         for (int j {0}; j < static_cast<int>(inputs.size()); j++) {
@@ -254,9 +264,11 @@ int main() {
                 continue;
 
             SnailfishNumber a = SnailfishNumber(); 
-            std::istringstream(inputs[i]) >> a;
+            aoc::Cursor a_in {inputs[i]};
+            a_in >> a;
             SnailfishNumber b = SnailfishNumber();
-            std::istringstream(inputs[j]) >> b;
+            aoc::Cursor b_in {inputs[j]};
+            b_in >> b;
 
             std::unique_ptr<SnailfishNumber> res = SnailfishNumber::append(std::move(a), std::move(b));
             int mag {res->magnitude()};
@@ -266,5 +278,10 @@ int main() {
         }
     }
     
-    std::cout << best_magnitude << '\n';
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(best_magnitude);
+}
+
+AOC_REGISTER_SOLVER(18, 2, "reference", solve);
+
 }
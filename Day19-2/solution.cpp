@@ -8,9 +8,17 @@
 #include <optional>
 #include <queue>
 #include <set>
-#include <sstream>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+#include "../Day19-common/beacon_set.hpp"
+#include "../Day19-common/incremental_map.hpp"
+#include "../Day19-common/rotation.hpp"
+#include "../Day19-common/scanner_map.hpp"
+
+namespace day19_part2 {
 
 struct Triple {
 public:
@@ -18,7 +26,7 @@ public:
     int y {};
     int z {};
 
-    friend std::istream& operator>>(std::istream& in, Triple& triple);
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, Triple& triple);
 
     friend std::strong_ordering operator<=>(const Triple& lhs, const Triple& rhs) = default;
 
@@ -44,63 +52,34 @@ public:
     };
 
 private:
-    std::vector<std::pair<Axis, Axis>> steps {};
-
-    int& select_axis(Axis ax, Triple& t) const {
-        if (ax == Axis::X)
-            return t.x;
-        if (ax == Axis::Y)
-            return t.y;
-        if (ax == Axis::Z)
-            return t.z;
-
-        assert(false && "Should not reach this point");
-    }
+    /* An index into the table of all 24 (see Day19-common/rotation.hpp). */
+    day19::Rotation rotation {};
 
 public:
-    /* This could be smarter, removing instructions if some reverse or compose etc. */
+    /* One step swaps two axes, then negates the from axis: a quarter turn. */
     Rotation& add_step(Axis from, Axis to) {
         if (from == to)
             return *this;
 
-        steps.push_back({from, to});
+        rotation = day19::Rotation::quarter_turn(static_cast<int>(from), static_cast<int>(to)) * rotation;
 
         return *this;
     }
 
     Triple rotate(Triple t) const {
-        for (auto [from, to] : steps) {
-            int& from_i {select_axis(from, t)};
-            int& to_i {select_axis(to, t)};
-
-            std::swap(from_i, to_i);
-            from_i *= -1;
-        }
-
-        return t;
+        return rotation.apply(t);
     }
 
     Rotation reverse() const {
         Rotation rev {};
-
-        // The order of the steps are reversed.
-        for (auto it {steps.rbegin()}; it != steps.rend(); it++) {
-            auto [from, to] = *it;
-            rev.add_step(to, from); // The steps are reversed internally.
-        }
-
+        rev.rotation = rotation.inverse();
         return rev;
     }
 
+    /* a's steps, then b's. */
     friend Rotation operator+(const Rotation& a, const Rotation& b) {
         Rotation rot {};
-        
-        for (auto [from, to] : a.steps) 
-            rot.add_step(from, to);
-
-        for (auto [from, to] : b.steps) 
-            rot.add_step(from, to);
-
+        rot.rotation = b.rotation * a.rotation;
         return rot;
     }
 };
@@ -185,6 +164,8 @@ public:
     std::vector<Triple> original_triples {};
 
     void construct_rotated_displacements() {
+        AOC_TRACE_SCOPE("construct_rotated_displacements");
+
         /* Construct one displacement per each ordered pair (so xy and yx). They
          * do end up with different rotated_displacements. */
         for (int i {0}; i < static_cast<int>(original_triples.size()); i++) {
@@ -197,6 +178,7 @@ public:
     }
 
     std::optional<std::pair<Triple, Rotation>> attempt_connect(Scanner& other) {
+        AOC_TRACE_ADD("attempt_connect", 1);
         std::multiset<DisplacementInfo> intersection {}; // Must allow for multiple elements.
 
         /* Copies items from the first iterator, if equivalent items exist in the
@@ -208,6 +190,7 @@ public:
         /* If 12 common probes exist, there will be (at least) 12 * 11 common displacements. */
         if (intersection.size() < 132) 
             return std::nullopt;
+        AOC_TRACE_ADD("attempt_connect_past_132", 1);
         
         /* This might not be truly rock solid, but I bet it will work. */
         for (const DisplacementInfo& info : intersection) {
@@ -251,7 +234,7 @@ public:
         return std::nullopt;
     }
 
-    friend std::istream& operator>>(std::istream& in, Scanner& scanner);
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, Scanner& scanner);
 };
 
 class ScannerMap {
@@ -262,6 +245,8 @@ public:
 
 public:
     void construct_map() {
+        AOC_TRACE_SCOPE("construct_map");
+
         for (Scanner& sc : scanners) {
             sc.construct_rotated_displacements();
         }
@@ -295,13 +280,11 @@ public:
                 }
             }
         }
-
-        std::cout << "Map fully built" << '\n';
     }
 
     /* Assumes constructed map. */
     int count_beacons() {
-        std::set<Triple> beacons {};
+        day19::BeaconSet beacons {}; // Packed coordinates (see Day19-common/beacon_set.hpp).
 
         for (int i {0}; i < static_cast<int>(scanners.size()); i++) {
             for (const Triple& t: scanners[i].original_triples) {
@@ -314,68 +297,117 @@ public:
         return beacons.size();
     }
 
-    friend std::istream& operator>>(std::istream& in, ScannerMap& scanner_map);
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, ScannerMap& scanner_map);
 };
 
 /* Parsing Input */
 
-std::istream& operator>>(std::istream& in, Triple& triple) {
+aoc::Cursor& operator>>(aoc::Cursor& in, Triple& triple) {
     char buf {};
-    in >> triple.x >> buf >> triple.y >> buf >> triple.z;
-    in.ignore(); // Clear the newline as well.
-
-    return in;
+    return in >> triple.x >> buf >> triple.y >> buf >> triple.z;
 }
 
-std::istream& operator>>(std::istream& in, Scanner& scanner) {
+aoc::Cursor& operator>>(aoc::Cursor& in, Scanner& scanner) {
     scanner = {};
-    std::string buf {};
-    std::getline(in, buf); // --- scanner # ---
+    std::string_view buf {};
+    in.getline(buf); // --- scanner # ---
 
-    while (std::getline(in, buf)) {
+    while (in.getline(buf)) {
         if (buf.size() == 0)
             break;
 
         scanner.original_triples.push_back({});
-        std::istringstream {buf} >> scanner.original_triples.back();
+        aoc::Cursor line {buf};
+        line >> scanner.original_triples.back();
     }
 
     return in;
 }
 
-std::istream& operator>>(std::istream& in, ScannerMap& scanner_map) {
+aoc::Cursor& operator>>(aoc::Cursor& in, ScannerMap& scanner_map) {
     scanner_map = {};
     Scanner sc {};
 
-    while (in >> sc) {
+    /* The last scanner runs into the end of the input rather than a blank line,
+     * so check for leftover text instead of relying on the extraction failing. */
+    while (!in.at_end()) {
+        in >> sc;
         scanner_map.scanners.push_back(sc);   
     }
 
-    scanner_map.scanners.push_back(sc); // Due to lack of white space, last scanner cause cin to fail.
-
     return in;
 }
 
 /* Main */
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     ScannerMap sm {};
-    std::cin >> sm;
+    in >> sm;
 
+    AOC_TRACE_NEXT_PHASE("build");
     sm.construct_map();
 
-    /* There is nothing to fear in O(n^2) when n is only ~40! */
-    int biggest_distance {0};
-    for (std::optional<Triple> ot1 : sm.scanner_locations) {
-        for (std::optional<Triple> ot2 : sm.scanner_locations) {
-            Triple d {ot1.value() - ot2.value()};
-            int dist {std::abs(d.x) + std::abs(d.y) + std::abs(d.z)};
-            if (dist > biggest_distance)
-                biggest_distance = dist;
-        }
-    }
+    AOC_TRACE_NEXT_PHASE("solve");
+    /* The farthest two scanners are the furthest apart along one of the four
+     * directions (1, +-1, +-1), so one pass finds them (see
+     * Day19-common/beacon_set.hpp). */
+    day19::ManhattanExtremes extremes {};
+    for (std::optional<Triple> ot : sm.scanner_locations)
+        extremes.add(ot.value());
+    long biggest_distance {extremes.max_distance()};
+
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(biggest_distance);
+}
+
+AOC_REGISTER_SOLVER(19, 2, "reference", solve);
+
+/* See Day19-common/scanner_map.hpp. */
+std::string solve_indexed(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    day19::ScannerMap sm {day19::parse_scanners(input)};
+
+    AOC_TRACE_NEXT_PHASE("build");
+    sm.construct_map();
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    return std::to_string(sm.max_distance());
+}
+
+AOC_REGISTER_SOLVER(19, 2, "indexed", solve_indexed);
+
+/* The same, aligning scanners on every core. */
+std::string solve_parallel(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    day19::ScannerMap sm {day19::parse_scanners(input)};
+
+    AOC_TRACE_NEXT_PHASE("build");
+    sm.construct_map_parallel(aoc::ThreadPool::default_threads());
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    return std::to_string(sm.max_distance());
+}
+
+AOC_REGISTER_SOLVER(19, 2, "parallel", solve_parallel);
+
+/* The same, adding one scanner at a time (see Day19-common/incremental_map.hpp). */
+std::string solve_incremental(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    std::vector<day19::Scanner> scanners {day19::parse_scanners(input)};
+
+    AOC_TRACE_NEXT_PHASE("build");
+    day19::IncrementalScannerMap sm {};
+    for (day19::Scanner& sc : scanners)
+        sm.add_scanner(std::move(sc));
+    sm.check_all_placed();
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    return std::to_string(sm.max_distance());
+}
 
-    std::cout << biggest_distance << '\n';
+AOC_REGISTER_SOLVER(19, 2, "incremental", solve_incremental);
 
-    return 0;
 }
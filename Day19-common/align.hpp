@@ -0,0 +1,152 @@
+#pragma once
+
+/* Aligning two scanners by voting. For each of the 24 orientations of b,
+ * every beacon of a and every rotated beacon of b vote for the offset that
+ * would put the one on the other; 12 votes for one offset is a match. Nothing
+ * is sorted and, once the voter has grown to the scanners' size, nothing is
+ * allocated.
+ *
+ * Beacons are kept as separate x, y and z arrays, so rotating b and
+ * subtracting it from a beacon of a are plain loops over ints, which the
+ * compiler vectorizes. The votes go into an open-addressed table that is
+ * reused between orientations rather than cleared: a slot only counts if it
+ * was written in the current round. */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "../common/hash.hpp"
+#include "rotation.hpp"
+
+namespace day19 {
+
+struct BeaconArrays {
+    std::vector<int> x {};
+    std::vector<int> y {};
+    std::vector<int> z {};
+
+    size_t size() const { return x.size(); }
+
+    void push_back(int px, int py, int pz) {
+        x.push_back(px);
+        y.push_back(py);
+        z.push_back(pz);
+    }
+};
+
+/* b's beacons p are at rotation.apply(p) + offset in a's coordinates. */
+struct Alignment {
+    Rotation rotation {};
+    std::array<int, 3> offset {};
+};
+
+class OffsetVoter {
+private:
+    /* Offsets are packed 21 bits per axis, so must lie within +-2^20;
+     * align() refuses scanners whose beacons could be further apart. */
+    static constexpr int bias {1 << 20};
+
+    struct Slot {
+        std::uint64_t key {};
+        std::uint32_t round {0};
+        int votes {};
+    };
+
+    std::vector<Slot> table {};
+    std::uint32_t round {0};
+
+    std::vector<int> rx {}; // b, rotated.
+    std::vector<int> ry {};
+    std::vector<int> rz {};
+    std::vector<std::uint64_t> keys {}; // Offsets from one beacon of a.
+
+    void prepare(size_t a_size, size_t b_size) {
+        /* At most a_size * b_size distinct offsets a round: half full. */
+        size_t slots {std::bit_ceil(std::max<size_t>(64, 2 * a_size * b_size))};
+        if (table.size() < slots) {
+            table.assign(slots, {});
+            round = 0;
+        }
+        rx.resize(b_size);
+        ry.resize(b_size);
+        rz.resize(b_size);
+        keys.resize(b_size);
+    }
+
+    static long max_abs(const BeaconArrays& p) {
+        long biggest {0};
+        for (size_t i {0}; i < p.size(); i++)
+            biggest = std::max({biggest, std::labs(p.x[i]), std::labs(p.y[i]), std::labs(p.z[i])});
+        return biggest;
+    }
+
+    void next_round() {
+        if (++round == 0) {
+            std::fill(table.begin(), table.end(), Slot {});
+            round = 1;
+        }
+    }
+
+    int vote(std::uint64_t key) {
+        size_t mask {table.size() - 1};
+        size_t slot {static_cast<size_t>(aoc::mix_hash(key)) & mask};
+        while (table[slot].round == round && table[slot].key != key)
+            slot = (slot + 1) & mask;
+
+        if (table[slot].round != round) {
+            table[slot] = {key, round, 1};
+            return 1;
+        }
+        return ++table[slot].votes;
+    }
+
+public:
+    std::optional<Alignment> align(const BeaconArrays& a, const BeaconArrays& b, int threshold = 12) {
+        if (static_cast<int>(a.size()) < threshold || static_cast<int>(b.size()) < threshold)
+            return std::nullopt;
+        if (max_abs(a) + max_abs(b) >= bias)
+            throw std::out_of_range("beacon offsets beyond +-2^20");
+        prepare(a.size(), b.size());
+        const size_t n {b.size()};
+
+        for (int r {0}; r < 24; r++) {
+            const Matrix& m {rotation_matrices[r]};
+            for (size_t j {0}; j < n; j++) {
+                rx[j] = m[0][0] * b.x[j] + m[0][1] * b.y[j] + m[0][2] * b.z[j];
+                ry[j] = m[1][0] * b.x[j] + m[1][1] * b.y[j] + m[1][2] * b.z[j];
+                rz[j] = m[2][0] * b.x[j] + m[2][1] * b.y[j] + m[2][2] * b.z[j];
+            }
+
+            next_round();
+            for (size_t i {0}; i < a.size(); i++) {
+                const int ax {a.x[i] + bias};
+                const int ay {a.y[i] + bias};
+                const int az {a.z[i] + bias};
+                for (size_t j {0}; j < n; j++) {
+                    keys[j] = (static_cast<std::uint64_t>(ax - rx[j]) << 42)
+                            | (static_cast<std::uint64_t>(ay - ry[j]) << 21)
+                            | static_cast<std::uint64_t>(az - rz[j]);
+                }
+
+                for (size_t j {0}; j < n; j++) {
+                    if (vote(keys[j]) >= threshold) {
+                        return Alignment {Rotation::from_id(r), {
+                            static_cast<int>(keys[j] >> 42) - bias,
+                            static_cast<int>((keys[j] >> 21) & 0x1fffff) - bias,
+                            static_cast<int>(keys[j] & 0x1fffff) - bias}};
+                    }
+                }
+            }
+        }
+
+        return std::nullopt;
+    }
+};
+
+}
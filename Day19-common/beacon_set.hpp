@@ -0,0 +1,87 @@
+#pragma once
+
+/* The two answers, cheaply at any scale: a flat set of beacons to count the
+ * distinct ones, and the largest Manhattan distance between scanners in one
+ * pass. Both work on any point type with x, y and z. */
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <set>
+
+#include "flat_counter.hpp"
+
+namespace day19 {
+
+/* Points packed 21 bits per axis into 64-bit keys of a FlatCounter, each
+ * counted once. The rare point with a coordinate beyond +-2^20 goes into an
+ * ordinary set instead. */
+class BeaconSet {
+private:
+    static constexpr std::int64_t bias {1 << 20};
+
+    FlatCounter seen; // Bit 63 is never set by a key, so ~0 stays free.
+    std::set<std::array<std::int64_t, 3>> far {};
+
+    static bool fits(std::int64_t x, std::int64_t y, std::int64_t z) {
+        return std::max({std::abs(x), std::abs(y), std::abs(z)}) < bias;
+    }
+
+    static std::uint64_t pack(std::int64_t x, std::int64_t y, std::int64_t z) {
+        return (static_cast<std::uint64_t>(x + bias) << 42)
+             | (static_cast<std::uint64_t>(y + bias) << 21)
+             | static_cast<std::uint64_t>(z + bias);
+    }
+
+public:
+    explicit BeaconSet(size_t capacity = 512) : seen {capacity} {}
+
+    /* Whether t was new. */
+    template<typename T>
+    bool insert(const T& t) {
+        if (!fits(t.x, t.y, t.z))
+            return far.insert({t.x, t.y, t.z}).second;
+        return seen[pack(t.x, t.y, t.z)]++ == 0;
+    }
+
+    size_t size() const { return seen.size() + far.size(); }
+};
+
+/* |dx| + |dy| + |dz| is the largest of the four projections
+ * |dx +- dy +- dz|, so the largest distance between any two points is the
+ * widest spread of the points along one of those four directions. Keeping
+ * each direction's minimum and maximum makes that one pass over the points,
+ * and adding a point O(1). */
+class ManhattanExtremes {
+private:
+    std::array<long, 4> lowest {LONG_MAX, LONG_MAX, LONG_MAX, LONG_MAX};
+    std::array<long, 4> highest {LONG_MIN, LONG_MIN, LONG_MIN, LONG_MIN};
+
+public:
+    template<typename T>
+    void add(const T& t) {
+        const std::array<long, 4> projections {
+            static_cast<long>(t.x) + t.y + t.z,
+            static_cast<long>(t.x) + t.y - t.z,
+            static_cast<long>(t.x) - t.y + t.z,
+            static_cast<long>(t.x) - t.y - t.z};
+        for (int k {0}; k < 4; k++) {
+            lowest[k] = std::min(lowest[k], projections[k]);
+            highest[k] = std::max(highest[k], projections[k]);
+        }
+    }
+
+    /* The largest distance between two of the points added, or 0. */
+    long max_distance() const {
+        long biggest {0};
+        for (int k {0}; k < 4; k++) {
+            if (highest[k] >= lowest[k])
+                biggest = std::max(biggest, highest[k] - lowest[k]);
+        }
+        return biggest;
+    }
+};
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+/* The open-addressed table of 64-bit keys that the fingerprint votes and the
+ * beacon set are both built on. */
+
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../common/hash.hpp"
+
+namespace day19 {
+
+/* A count per 64-bit key, open addressed and at most half full. */
+class FlatCounter {
+private:
+    static constexpr std::uint64_t empty {~std::uint64_t {0}};
+
+    std::vector<std::pair<std::uint64_t, int>> slots {};
+    size_t used {0};
+
+    size_t slot_of(std::uint64_t key) const {
+        size_t mask {slots.size() - 1};
+        size_t slot {static_cast<size_t>(aoc::mix_hash(key)) & mask};
+        while (slots[slot].first != empty && slots[slot].first != key)
+            slot = (slot + 1) & mask;
+        return slot;
+    }
+
+public:
+    explicit FlatCounter(size_t capacity = 512) : slots(std::bit_ceil(2 * capacity), {empty, 0}) {}
+
+    /* Any key but ~0. */
+    int& operator[](std::uint64_t key) {
+        size_t slot {slot_of(key)};
+        if (slots[slot].first == empty) {
+            if (2 * (used + 1) > slots.size()) {
+                std::vector<std::pair<std::uint64_t, int>> old(2 * slots.size(), {empty, 0});
+                old.swap(slots);
+                for (const auto& entry : old) {
+                    if (entry.first != empty)
+                        slots[slot_of(entry.first)] = entry;
+                }
+                slot = slot_of(key);
+            }
+            slots[slot].first = key;
+            used++;
+        }
+        return slots[slot].second;
+    }
+
+    size_t size() const { return used; }
+
+    template<typename Visit>
+    void for_each(Visit visit) const {
+        for (const auto& [key, count] : slots) {
+            if (key != empty)
+                visit(key, count);
+        }
+    }
+};
+
+}
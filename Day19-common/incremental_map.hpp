@@ -0,0 +1,119 @@
+#pragma once
+
+/* A scanner map that takes scanners one at a time, for reports that arrive
+ * over time (the "incremental" engine).
+ *
+ * Each new scanner goes into the same fingerprint index as the batch engines
+ * use (scanner_map.hpp), which also finds the scanners it overlaps. It is
+ * aligned against the placed ones among those; if none fit, it waits. When a
+ * scanner is placed, the waiting scanners it overlaps are tried against it,
+ * and those placed in turn are tried against the rest, and so on. The beacon
+ * count and the largest distance between two scanners are updated as each
+ * scanner is placed, so both can be asked for at any time. */
+
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "beacon_set.hpp"
+#include "scanner_map.hpp"
+
+namespace day19 {
+
+class IncrementalScannerMap {
+private:
+    std::vector<Scanner> scanners {};
+    FingerprintIndex index {};
+    std::vector<std::optional<Pose>> poses {}; // Relative to the first scanner.
+    size_t pending {0};
+    OffsetVoter voter {}; // Scratch space, kept between alignments.
+
+    BeaconSet beacons {}; // Of the placed scanners.
+    ManhattanExtremes extremes {}; // Of their positions.
+
+    void place(int s, const Pose& pose) {
+        AOC_TRACE_ADD("scanners_placed", 1);
+        poses[s] = pose;
+        for (const Triple& t : scanners[s].beacons)
+            beacons.insert(pose.apply(t));
+        extremes.add(pose.position);
+    }
+
+    /* Whatever now overlaps a placed scanner, starting from s. */
+    void place_waiting_from(int s) {
+        std::queue<int> newly_placed {};
+        newly_placed.push(s);
+
+        while (!newly_placed.empty() && pending > 0) {
+            int known {newly_placed.front()};
+            newly_placed.pop();
+
+            for (int other : index.overlapping(known, 66)) {
+                if (poses[other].has_value())
+                    continue;
+
+                std::optional<Pose> relative {align(scanners, index, known, other, voter)};
+                if (relative.has_value()) {
+                    place(other, *poses[known] * *relative);
+                    pending--;
+                    newly_placed.push(other);
+                }
+            }
+        }
+    }
+
+public:
+    /* The first scanner added is the origin. Returns the scanner's number,
+     * counting from 0 in the order they were added. */
+    int add_scanner(Scanner scanner) {
+        int s {static_cast<int>(scanners.size())};
+        prepare_scanner(scanner);
+        scanners.push_back(std::move(scanner));
+        poses.push_back(std::nullopt);
+        index.add(s, scanners[s].beacons);
+
+        if (s == 0)
+            place(s, Pose {});
+        else {
+            for (int other : index.overlapping(s, 66)) {
+                if (!poses[other].has_value())
+                    continue;
+
+                std::optional<Pose> relative {align(scanners, index, other, s, voter)};
+                if (relative.has_value()) {
+                    place(s, *poses[other] * *relative);
+                    break;
+                }
+            }
+        }
+
+        if (!poses[s].has_value()) {
+            AOC_TRACE_ADD("scanners_waiting", 1);
+            pending++;
+        }
+        else
+            place_waiting_from(s);
+
+        return s;
+    }
+
+    size_t size() const { return scanners.size(); }
+
+    void check_all_placed() const {
+        for (int s {0}; s < static_cast<int>(scanners.size()); s++) {
+            if (!poses[s].has_value())
+                throw std::runtime_error("scanner " + std::to_string(s) + " overlaps no placed scanner");
+        }
+    }
+
+    /* Distinct beacons seen by the placed scanners. */
+    int beacon_count() const { return beacons.size(); }
+
+    /* The largest Manhattan distance between two placed scanners. */
+    int max_distance() const { return extremes.max_distance(); }
+};
+
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+/* The 24 ways a scanner can be turned, as a table of 3x3 integer matrices
+ * built at compile time, along with every product and inverse. A rotation is
+ * then just its index into the table: turning a point is a matrix multiply
+ * with no branches, and combining or undoing rotations is a lookup. */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace day19 {
+
+using Matrix = std::array<std::array<int, 3>, 3>;
+
+constexpr Matrix multiply(const Matrix& a, const Matrix& b) {
+    Matrix m {};
+    for (int row {0}; row < 3; row++) {
+        for (int col {0}; col < 3; col++) {
+            for (int k {0}; k < 3; k++)
+                m[row][col] += a[row][k] * b[k][col];
+        }
+    }
+    return m;
+}
+
+constexpr Matrix transpose(const Matrix& a) {
+    Matrix m {};
+    for (int row {0}; row < 3; row++) {
+        for (int col {0}; col < 3; col++)
+            m[row][col] = a[col][row];
+    }
+    return m;
+}
+
+constexpr int determinant(const Matrix& m) {
+    return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+         - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+         + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+}
+
+/* Every signed permutation matrix with determinant 1. The identity is first. */
+constexpr std::array<Matrix, 24> rotation_matrices {[] {
+    std::array<Matrix, 24> rotations {};
+    int count {0};
+
+    std::array<int, 3> perm {0, 1, 2};
+    do {
+        for (int signs {0}; signs < 8; signs++) {
+            Matrix m {};
+            for (int row {0}; row < 3; row++)
+                m[row][perm[row]] = (signs >> row) & 1 ? -1 : 1;
+            if (determinant(m) == 1)
+                rotations[count++] = m;
+        }
+    } while (std::next_permutation(perm.begin(), perm.end()));
+
+    return rotations;
+}()};
+
+/* The index of m in rotation_matrices, or -1 if it is not a rotation. */
+constexpr int find_rotation(const Matrix& m) {
+    for (int r {0}; r < 24; r++) {
+        if (rotation_matrices[r] == m)
+            return r;
+    }
+    return -1;
+}
+
+/* rotation_products[a][b] rotates by b, then by a. */
+constexpr std::array<std::array<std::uint8_t, 24>, 24> rotation_products {[] {
+    std::array<std::array<std::uint8_t, 24>, 24> products {};
+    for (int a {0}; a < 24; a++) {
+        for (int b {0}; b < 24; b++)
+            products[a][b] = find_rotation(multiply(rotation_matrices[a], rotation_matrices[b]));
+    }
+    return products;
+}()};
+
+/* A rotation matrix's inverse is its transpose. */
+constexpr std::array<std::uint8_t, 24> rotation_inverses {[] {
+    std::array<std::uint8_t, 24> inverses {};
+    for (int r {0}; r < 24; r++)
+        inverses[r] = find_rotation(transpose(rotation_matrices[r]));
+    return inverses;
+}()};
+
+static_assert(rotation_products[5][rotation_inverses[5]] == 0);
+static_assert(rotation_products[rotation_products[3][7]][11] == rotation_products[3][rotation_products[7][11]]);
+
+class Rotation {
+private:
+    std::uint8_t index {0}; // Into rotation_matrices.
+
+    constexpr explicit Rotation(int index) : index {static_cast<std::uint8_t>(index)} {}
+
+public:
+    constexpr Rotation() = default;
+
+    /* Only for rotation matrices (see find_rotation). */
+    static constexpr Rotation from_matrix(const Matrix& m) {
+        return Rotation {find_rotation(m)};
+    }
+
+    /* The quarter turn that moves the from axis onto the to axis. */
+    static constexpr Rotation quarter_turn(int from, int to) {
+        Matrix m {};
+        m[to][from] = 1;
+        m[from][to] = -1;
+        m[3 - from - to][3 - from - to] = 1;
+        return from_matrix(m);
+    }
+
+    /* The inverse of id(), for 0 to 23. */
+    static constexpr Rotation from_id(int id) {
+        return Rotation {id};
+    }
+
+    constexpr int id() const { return index; }
+
+    /* For any point type with x, y and z. */
+    template<typename T>
+    T apply(const T& t) const {
+        const Matrix& m {rotation_matrices[index]};
+        return {m[0][0] * t.x + m[0][1] * t.y + m[0][2] * t.z,
+                m[1][0] * t.x + m[1][1] * t.y + m[1][2] * t.z,
+                m[2][0] * t.x + m[2][1] * t.y + m[2][2] * t.z};
+    }
+
+    constexpr Rotation inverse() const {
+        return Rotation {rotation_inverses[index]};
+    }
+
+    /* a * b rotates by b, then by a. */
+    friend constexpr Rotation operator*(const Rotation& a, const Rotation& b) {
+        return Rotation {rotation_products[a.index][b.index]};
+    }
+
+    friend constexpr bool operator==(const Rotation& lhs, const Rotation& rhs) = default;
+};
+
+}
@@ -0,0 +1,500 @@
+#pragma once
+
+/* Day 19 for large scanner sets: the "indexed" engine, shared by both parts.
+ *
+ * The reference solution compares scanners two at a time, intersecting their
+ * sets of beacon-to-beacon displacements, so S scanners cost O(S^2) set
+ * intersections. Here each pair of beacons seen by a scanner is fingerprinted
+ * by something no rotation changes, the sorted absolute values of its
+ * displacement, and filed in one index from fingerprint to the (scanner, i, j)
+ * pairs that have it. Two scanners that see 12 common beacons share at least
+ * 12 * 11 / 2 = 66 fingerprints, so a single pass over the index finds every
+ * pair of scanners worth aligning, and only those pairs are aligned. */
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../common/hash.hpp"
+#include "../common/input.hpp"
+#include "../common/thread_pool.hpp"
+#include "../common/trace.hpp"
+#include "align.hpp"
+#include "beacon_set.hpp"
+#include "flat_counter.hpp"
+#include "rotation.hpp"
+
+namespace day19 {
+
+struct Triple {
+    int x {};
+    int y {};
+    int z {};
+
+    int operator[](int axis) const {
+        return axis == 0 ? x : axis == 1 ? y : z;
+    }
+
+    friend std::strong_ordering operator<=>(const Triple& lhs, const Triple& rhs) = default;
+
+    friend Triple operator-(const Triple& a, const Triple& b) {
+        return {a.x - b.x, a.y - b.y, a.z - b.z};
+    }
+
+    friend Triple operator+(const Triple& a, const Triple& b) {
+        return {a.x + b.x, a.y + b.y, a.z + b.z};
+    }
+};
+
+/* Where a scanner is, relative to another (or to scanner 0): a point p that
+ * the scanner reports is at rotation.apply(p) + position. */
+struct Pose {
+    Rotation rotation {};
+    Triple position {};
+
+    Triple apply(const Triple& t) const {
+        return rotation.apply(t) + position;
+    }
+
+    /* a * b places by b, then by a. */
+    friend Pose operator*(const Pose& a, const Pose& b) {
+        return {a.rotation * b.rotation, a.apply(b.position)};
+    }
+};
+
+struct Scanner {
+    std::vector<Triple> beacons {};
+    std::vector<Triple> sorted_beacons {}; // For membership tests while aligning.
+    BeaconArrays arrays {};                // For the offset voter.
+};
+
+/* Fills in the rest of a scanner from its beacons. */
+inline void prepare_scanner(Scanner& sc) {
+    sc.sorted_beacons = sc.beacons;
+    std::sort(sc.sorted_beacons.begin(), sc.sorted_beacons.end());
+    sc.arrays = {};
+    for (const Triple& t : sc.beacons)
+        sc.arrays.push_back(t.x, t.y, t.z);
+}
+
+inline std::vector<Scanner> parse_scanners(std::string_view input) {
+    std::vector<Scanner> scanners {};
+
+    for (std::string_view line : aoc::lines(input)) {
+        if (line.empty())
+            continue;
+        if (line.starts_with("---")) {
+            scanners.push_back({});
+            continue;
+        }
+        if (scanners.empty())
+            throw std::invalid_argument("beacon before the first scanner header");
+
+        Triple t {};
+        char comma {};
+        aoc::Cursor in {line};
+        if (!(in >> t.x >> comma >> t.y >> comma >> t.z))
+            throw std::invalid_argument("bad beacon: " + std::string {line});
+        scanners.back().beacons.push_back(t);
+    }
+
+    for (Scanner& sc : scanners)
+        prepare_scanner(sc);
+    return scanners;
+}
+
+/* The sorted absolute components of a displacement, packed into 21 bits each.
+ * Within one scanner's range they take at most 11. */
+inline std::uint64_t fingerprint(const Triple& d) {
+    std::array<std::uint64_t, 3> c {
+        static_cast<std::uint64_t>(std::abs(d.x)),
+        static_cast<std::uint64_t>(std::abs(d.y)),
+        static_cast<std::uint64_t>(std::abs(d.z))};
+    std::sort(c.begin(), c.end());
+    return ((c[0] & 0x1fffff) << 42) | ((c[1] & 0x1fffff) << 21) | (c[2] & 0x1fffff);
+}
+
+class FingerprintIndex {
+public:
+    struct Posting {
+        std::uint64_t key {};
+        int scanner {};
+        int i {};
+        int j {};
+        int next {-1}; // Previous posting with the same key, or -1.
+    };
+
+private:
+    /* Postings with the same key form a chain through next. The table holds
+     * the newest posting of each chain, open addressed: a slot is -1 or a
+     * posting index, whose key says which chain it is. */
+    std::vector<Posting> postings {};
+    std::vector<int> table {};
+    size_t chains {0};
+    std::vector<std::pair<int, int>> ranges {}; // Each scanner's postings.
+
+    size_t slot_of(std::uint64_t key) const {
+        size_t mask {table.size() - 1};
+        size_t slot {static_cast<size_t>(aoc::mix_hash(key)) & mask};
+        while (table[slot] != -1 && postings[table[slot]].key != key)
+            slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void rehash(size_t slots) {
+        std::vector<int> old {std::move(table)};
+        table.assign(slots, -1);
+        for (int head : old) {
+            if (head != -1)
+                table[slot_of(postings[head].key)] = head;
+        }
+    }
+
+public:
+    size_t size() const { return postings.size(); }
+
+    /* Room for this many more postings without rehashing. */
+    void reserve(size_t more) {
+        postings.reserve(postings.size() + more);
+        size_t slots {std::max<size_t>(1024, table.size())};
+        while (slots < 2 * (chains + more))
+            slots *= 2;
+        if (slots > table.size())
+            rehash(slots);
+    }
+
+    void add(int scanner, const std::vector<Triple>& beacons) {
+        if (static_cast<int>(ranges.size()) <= scanner)
+            ranges.resize(scanner + 1);
+        ranges[scanner].first = postings.size();
+
+        for (int i {0}; i < static_cast<int>(beacons.size()); i++) {
+            for (int j {i + 1}; j < static_cast<int>(beacons.size()); j++) {
+                if (2 * (chains + 1) > table.size())
+                    rehash(std::max<size_t>(1024, 2 * table.size())); // At most half full.
+
+                std::uint64_t key {fingerprint(beacons[i] - beacons[j])};
+                size_t slot {slot_of(key)};
+                chains += table[slot] == -1;
+                postings.push_back({key, scanner, i, j, table[slot]});
+                table[slot] = postings.size() - 1;
+            }
+        }
+
+        ranges[scanner].second = postings.size();
+    }
+
+    /* Calls visit(mine, theirs) for each posting of scanner b and posting of
+     * scanner a with the same key, until it returns true. */
+    template<typename Visit>
+    bool for_each_shared(int a, int b, Visit visit) const {
+        for (int p {ranges[b].first}; p < ranges[b].second; p++) {
+            const Posting& mine {postings[p]};
+            for (int q {table[slot_of(mine.key)]}; q != -1; q = postings[q].next) {
+                if (postings[q].scanner == a && visit(mine, postings[q]))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    /* The other scanners sharing at least min_shared keys with scanner b,
+     * in order. */
+    std::vector<int> overlapping(int b, int min_shared) const {
+        FlatCounter votes {};
+        for (int p {ranges[b].first}; p < ranges[b].second; p++) {
+            for (int q {table[slot_of(postings[p].key)]}; q != -1; q = postings[q].next) {
+                if (postings[q].scanner != b)
+                    votes[postings[q].scanner]++;
+            }
+        }
+
+        std::vector<int> scanners {};
+        votes.for_each([&](std::uint64_t scanner, int count) {
+            if (count >= min_shared)
+                scanners.push_back(static_cast<int>(scanner));
+        });
+        std::sort(scanners.begin(), scanners.end());
+        return scanners;
+    }
+
+    /* Every pair of scanners (a < b) sharing at least min_shared keys. Each
+     * pair of postings with the same key is met once, walking the chain on
+     * from the later one; almost all chains end straight away, so this is
+     * one pass down the postings. */
+    std::vector<std::pair<int, int>> candidate_pairs(int min_shared) const {
+        AOC_TRACE_SCOPE("candidate_pairs");
+        FlatCounter votes {};
+
+        for (const Posting& p : postings) {
+            for (int q {p.next}; q != -1; q = postings[q].next) {
+                if (postings[q].scanner == p.scanner)
+                    continue;
+                std::uint64_t a {static_cast<std::uint64_t>(std::min(p.scanner, postings[q].scanner))};
+                std::uint64_t b {static_cast<std::uint64_t>(std::max(p.scanner, postings[q].scanner))};
+                votes[(a << 32) | b]++;
+            }
+        }
+
+        AOC_TRACE_COUNTER("scanner_pairs_sharing", votes.size());
+        std::vector<std::pair<int, int>> pairs {};
+        votes.for_each([&](std::uint64_t key, int count) {
+            if (count >= min_shared)
+                pairs.push_back({static_cast<int>(key >> 32), static_cast<int>(key & 0xffffffff)});
+        });
+        std::sort(pairs.begin(), pairs.end()); // Hash order would make the search order vary.
+        return pairs;
+    }
+};
+
+/* The signed permutation taking from to to, if the magnitudes of their
+ * components are distinct and non-zero, so that exactly one fits. It may be
+ * a reflection rather than a rotation. */
+inline std::optional<Matrix> permutation_between(const Triple& from, const Triple& to) {
+    Matrix m {};
+    std::array<bool, 3> used {};
+    for (int k {0}; k < 3; k++) {
+        int matches {0};
+        for (int axis {0}; axis < 3; axis++) {
+            if (from[axis] != 0 && std::abs(from[axis]) == std::abs(to[k])) {
+                m[k][axis] = from[axis] == to[k] ? 1 : -1;
+                used[axis] = true;
+                matches++;
+            }
+        }
+        if (matches != 1)
+            return std::nullopt;
+    }
+    if (!used[0] || !used[1] || !used[2])
+        return std::nullopt;
+    return m;
+}
+
+inline int count_common(const Scanner& a, const Scanner& b, const Pose& b_in_a) {
+    int common {0};
+    for (const Triple& t : b.beacons)
+        common += std::binary_search(a.sorted_beacons.begin(), a.sorted_beacons.end(), b_in_a.apply(t));
+    return common;
+}
+
+/* Where scanner b is relative to scanner a, if they see 12 common beacons.
+ * Each shared fingerprint proposes the rotation and offset that would line
+ * its two beacon pairs up, which is then checked against every beacon. Only
+ * if none of them can (every shared pair has repeated or zero components, so
+ * fits several rotations) are all 24 rotations tried by voting; the caller
+ * keeps the voter, so that allocates nothing once it has grown. */
+inline std::optional<Pose> align(const std::vector<Scanner>& scanners, const FingerprintIndex& index, int a, int b, OffsetVoter& voter) {
+    AOC_TRACE_ADD("alignments", 1);
+    const Scanner& sa {scanners[a]};
+    const Scanner& sb {scanners[b]};
+    std::optional<Pose> found {};
+    bool proposed {false};
+
+    index.for_each_shared(a, b, [&](const FingerprintIndex::Posting& mine, const FingerprintIndex::Posting& theirs) {
+        const Triple to {sa.beacons[theirs.i] - sa.beacons[theirs.j]};
+        std::optional<Matrix> m {permutation_between(sb.beacons[mine.i] - sb.beacons[mine.j], to)};
+        if (!m)
+            return false;
+        proposed = true;
+
+        /* A reflection means the pair is the other way round in b. */
+        Pose pose {};
+        if (determinant(*m) == 1) {
+            pose.rotation = Rotation::from_matrix(*m);
+            pose.position = sa.beacons[theirs.i] - pose.rotation.apply(sb.beacons[mine.i]);
+        }
+        else {
+            for (auto& row : *m)
+                for (int& entry : row)
+                    entry = -entry;
+            pose.rotation = Rotation::from_matrix(*m);
+            pose.position = sa.beacons[theirs.i] - pose.rotation.apply(sb.beacons[mine.j]);
+        }
+
+        AOC_TRACE_ADD("alignment_checks", 1);
+        if (count_common(sa, sb, pose) < 12)
+            return false;
+        found = pose;
+        return true;
+    });
+
+    if (!proposed) {
+        AOC_TRACE_ADD("alignments_by_voting", 1);
+        if (std::optional<Alignment> alignment {voter.align(sa.arrays, sb.arrays)}) {
+            auto [x, y, z] = alignment->offset;
+            found = Pose {alignment->rotation, {x, y, z}};
+        }
+    }
+
+    return found;
+}
+
+class ScannerMap {
+private:
+    std::vector<Scanner> scanners {};
+    FingerprintIndex index {};
+    std::vector<std::optional<Pose>> poses {}; // Relative to scanner 0.
+    OffsetVoter voter {}; // Scratch space for construct_map(), kept between alignments.
+
+    void build_index() {
+        AOC_TRACE_SCOPE("index");
+        if (scanners.empty())
+            throw std::invalid_argument("no scanners");
+
+        size_t pairs {0};
+        for (const Scanner& sc : scanners)
+            pairs += sc.beacons.size() * sc.beacons.size() / 2;
+        index.reserve(pairs);
+        for (int s {0}; s < static_cast<int>(scanners.size()); s++)
+            index.add(s, scanners[s].beacons);
+        AOC_TRACE_COUNTER("fingerprints", index.size());
+    }
+
+    void check_all_placed() const {
+        for (int s {0}; s < static_cast<int>(scanners.size()); s++) {
+            if (!poses[s].has_value())
+                throw std::runtime_error("scanner " + std::to_string(s) + " overlaps no placed scanner");
+        }
+    }
+
+public:
+    explicit ScannerMap(std::vector<Scanner> scanners) : scanners {std::move(scanners)} {}
+
+    /* Aligns candidate pairs one at a time, breadth first from scanner 0,
+     * skipping any pair whose second scanner is already placed. */
+    void construct_map() {
+        AOC_TRACE_SCOPE("construct_map");
+        build_index();
+
+        std::vector<std::vector<int>> neighbours(scanners.size());
+        for (auto [a, b] : index.candidate_pairs(66)) {
+            neighbours[a].push_back(b);
+            neighbours[b].push_back(a);
+        }
+
+        poses.assign(scanners.size(), std::nullopt);
+        poses[0] = Pose {};
+
+        std::queue<int> known_scanners {};
+        known_scanners.push(0);
+
+        while (!known_scanners.empty()) {
+            int known {known_scanners.front()};
+            known_scanners.pop();
+
+            for (int other : neighbours[known]) {
+                if (poses[other].has_value())
+                    continue;
+
+                std::optional<Pose> relative {align(scanners, index, known, other, voter)};
+                if (relative.has_value()) {
+                    poses[other] = *poses[known] * *relative;
+                    known_scanners.push(other);
+                }
+            }
+        }
+
+        check_all_placed();
+    }
+
+    /* The same breadth-first search, a whole frontier at a time: each
+     * scanner next to the frontier is aligned against its placed neighbours
+     * on a thread pool, and those that align form the next frontier. Every
+     * candidate pair is still tried at most once, as in construct_map(). The
+     * poses are exact, so whichever neighbour places a scanner, the map is
+     * the same. */
+    void construct_map_parallel(unsigned threads) {
+        AOC_TRACE_SCOPE("construct_map");
+        build_index();
+
+        std::vector<std::vector<int>> neighbours(scanners.size());
+        for (auto [a, b] : index.candidate_pairs(66)) {
+            neighbours[a].push_back(b);
+            neighbours[b].push_back(a);
+        }
+
+        poses.assign(scanners.size(), std::nullopt);
+        poses[0] = Pose {};
+
+        aoc::ThreadPool pool {threads};
+        std::vector<OffsetVoter> voters(4 * std::max(threads, 1u)); // One per job, kept between frontiers.
+        std::vector<int> frontier {0};
+        std::vector<std::vector<int>> placed_neighbours(scanners.size());
+
+        while (!frontier.empty()) {
+            AOC_TRACE_ADD("frontiers", 1);
+            std::vector<int> next {};
+            for (int known : frontier) {
+                for (int other : neighbours[known]) {
+                    if (poses[other].has_value())
+                        continue;
+                    if (placed_neighbours[other].empty())
+                        next.push_back(other);
+                    placed_neighbours[other].push_back(known);
+                }
+            }
+
+            /* Only poses of the frontier are read while the pool runs. */
+            std::vector<std::optional<Pose>> found(next.size());
+            size_t jobs {std::min(next.size(), voters.size())};
+            for (size_t job {0}; job < jobs; job++) {
+                pool.submit([&, job] {
+                    for (size_t k {next.size() * job / jobs}; k < next.size() * (job + 1) / jobs; k++) {
+                        for (int known : placed_neighbours[next[k]]) {
+                            std::optional<Pose> relative {align(scanners, index, known, next[k], voters[job])};
+                            if (relative.has_value()) {
+                                found[k] = *poses[known] * *relative;
+                                break;
+                            }
+                        }
+                    }
+                });
+            }
+            pool.wait();
+
+            frontier.clear();
+            for (size_t k {0}; k < next.size(); k++) {
+                placed_neighbours[next[k]].clear(); // Tried; later frontiers bring new ones.
+                if (found[k].has_value()) {
+                    poses[next[k]] = found[k];
+                    frontier.push_back(next[k]);
+                }
+            }
+        }
+
+        check_all_placed();
+    }
+
+    /* Assumes constructed map. */
+    int count_beacons() const {
+        size_t total {0};
+        for (const Scanner& sc : scanners)
+            total += sc.beacons.size();
+
+        BeaconSet beacons {total};
+        for (size_t s {0}; s < scanners.size(); s++) {
+            for (const Triple& t : scanners[s].beacons)
+                beacons.insert(poses[s]->apply(t));
+        }
+        return beacons.size();
+    }
+
+    /* Assumes constructed map. */
+    int max_distance() const {
+        ManhattanExtremes extremes {};
+        for (const std::optional<Pose>& pose : poses)
+            extremes.add(pose->position);
+        return extremes.max_distance();
+    }
+};
+
+}
@@ -6,8 +6,12 @@
 #include <array>
 #include <deque> /* Double ended queue. Efficient insert at front and back. Perfect! */
 #include <iostream>
-#include <sstream>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day20_part2 {
 
 struct EnhancementAlgorithm {
     std::array<bool, 512> lookup {};
@@ -19,7 +23,7 @@ private:
     bool everything_else {false};
 
 public:
-    friend std::istream& operator>>(std::istream& in, Image& image);
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, Image& image);
 
     bool get(int r, int c) {
         int n {static_cast<int>(simulated_matrix.size())};
@@ -29,6 +33,8 @@ public:
     }
 
     void enhance(const EnhancementAlgorithm& alg) {
+        AOC_TRACE_SCOPE("enhance");
+
         /* Expand the simulated region by one in each direction. */
         for (std::deque<bool>& row: simulated_matrix) {
             row.push_front(everything_else);
@@ -68,7 +74,7 @@ public:
     }
 };
 
-std::istream& operator>>(std::istream& in, EnhancementAlgorithm& alg) {
+aoc::Cursor& operator>>(aoc::Cursor& in, EnhancementAlgorithm& alg) {
     alg = {};
 
     for (int i {0}; i < 512; i++) {
@@ -80,16 +86,14 @@ std::istream& operator>>(std::istream& in, EnhancementAlgorithm& alg) {
     return in;
 }
 
-std::istream& operator>>(std::istream& in, Image& image) {
+aoc::Cursor& operator>>(aoc::Cursor& in, Image& image) {
     image = {};
 
-    std::string buffer {};
+    std::string_view buffer {};
     while (in >> buffer) {
         image.simulated_matrix.push_back({});
-        std::istringstream sstream {buffer};
 
-        char ch {};
-        while (sstream >> ch) {
+        for (char ch : buffer) {
             image.simulated_matrix.back().push_back(ch == '#');
         }
     }
@@ -97,19 +101,26 @@ std::istream& operator>>(std::istream& in, Image& image) {
     return in;
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     EnhancementAlgorithm alg {};
-    std::cin >> alg;
+    in >> alg;
 
     Image image {};
-    std::cin >> image;
+    in >> image;
 
+    AOC_TRACE_NEXT_PHASE("solve");
     /* Only change */
     for (int i {0}; i < 50; i++) {
         image.enhance(alg);
     }
 
-    std::cout << image.count_bright() << '\n';
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(image.count_bright());
+}
+
+AOC_REGISTER_SOLVER(20, 2, "reference", solve);
 
-    return 0;
 }
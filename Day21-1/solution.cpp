@@ -1,6 +1,12 @@
 
 #include <iostream>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day21_part1 {
+
 class Die {
 private:
     int rolls {0};
@@ -64,18 +70,25 @@ private:
     }    
 };
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     int start_space_1 {};
     int start_space_2 {};    
     
-    std::string buffer {};
-    std::cin >> buffer >> buffer >> buffer >> buffer >> start_space_1;
-    std::cin >> buffer >> buffer >> buffer >> buffer >> start_space_2;
+    std::string_view buffer {};
+    in >> buffer >> buffer >> buffer >> buffer >> start_space_1;
+    in >> buffer >> buffer >> buffer >> buffer >> start_space_2;
 
+    AOC_TRACE_NEXT_PHASE("solve");
     Game game {};
     game.play_game(start_space_1, start_space_2);
 
-    std::cout << game.get_loser().score * game.get_die().get_rolls() << '\n';
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(game.get_loser().score * game.get_die().get_rolls());
+}
+
+AOC_REGISTER_SOLVER(21, 1, "reference", solve);
 
-    return 0;
-}
\ No newline at end of file
+}
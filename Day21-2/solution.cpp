@@ -2,6 +2,12 @@
 #include <iostream>
 #include <map>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day21_part2 {
+
 /* This requires dynamic programming. (Memoization) */
 
 struct Player {
@@ -52,17 +58,24 @@ public:
     }
 };
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     int start_space_1 {};
     int start_space_2 {};    
     
-    std::string buffer {};
-    std::cin >> buffer >> buffer >> buffer >> buffer >> start_space_1;
-    std::cin >> buffer >> buffer >> buffer >> buffer >> start_space_2;
+    std::string_view buffer {};
+    in >> buffer >> buffer >> buffer >> buffer >> start_space_1;
+    in >> buffer >> buffer >> buffer >> buffer >> start_space_2;
 
+    AOC_TRACE_NEXT_PHASE("solve");
     Game game {};
     auto [p1_score, p2_score] = game.play_game_from({0, start_space_1}, {0, start_space_2});
-    std::cout << std::max(p1_score, p2_score) << '\n';
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(std::max(p1_score, p2_score));
+}
+
+AOC_REGISTER_SOLVER(21, 2, "reference", solve);
 
-    return 0;
-}
\ No newline at end of file
+}
@@ -13,6 +13,15 @@
 #include <map>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+#include "../Day22-common/bit_grid.hpp"
+#include "../Day22-common/signed_cuboids.hpp"
+#include "../Day22-common/sweep.hpp"
+
+namespace day22_part2 {
+
 struct Instruction {
     bool state {false};
     int x1;
@@ -23,9 +32,9 @@ struct Instruction {
     int z2;
 };
 
-std::istream& operator>>(std::istream& in, Instruction& instruction) {
+aoc::Cursor& operator>>(aoc::Cursor& in, Instruction& instruction) {
     char ch {};
-    std::string str {};
+    std::string_view str {};
 
     in >> str;
     instruction.state = str == "on";
@@ -64,6 +73,8 @@ struct Grid {
 };
 
 void slice_x_bounds(Grid& grid, const std::vector<Instruction> instructions) {
+    AOC_TRACE_SCOPE("slice_x_bounds");
+
     std::vector<int> slice_left_bounds {};
     for (const Instruction& instruction : instructions) {
         slice_left_bounds.push_back(instruction.x1);
@@ -84,6 +95,8 @@ void slice_x_bounds(Grid& grid, const std::vector<Instruction> instructions) {
 }
 
 void slice_y_bounds(Grid& grid, const std::vector<Instruction> instructions) {
+    AOC_TRACE_SCOPE("slice_y_bounds");
+
     for (const Instruction& instruction : instructions) {
         int curr_left_x {instruction.x1};
         while (curr_left_x <= instruction.x2 && grid.slices.contains(curr_left_x)) {
@@ -113,6 +126,8 @@ void slice_y_bounds(Grid& grid, const std::vector<Instruction> instructions) {
 }
 
 void slice_z_bounds(Grid& grid, const std::vector<Instruction> instructions) {
+    AOC_TRACE_SCOPE("slice_z_bounds");
+
     for (const Instruction& instruction : instructions) {
         int curr_left_x {instruction.x1};
         while (curr_left_x <= instruction.x2 && grid.slices.contains(curr_left_x)) {
@@ -150,6 +165,8 @@ void slice_z_bounds(Grid& grid, const std::vector<Instruction> instructions) {
 }
 
 void run_instructions(Grid& grid, const std::vector<Instruction> instructions) {
+    AOC_TRACE_SCOPE("run_instructions");
+
     for (const Instruction& instruction : instructions) {
 
         int curr_left_x {instruction.x1};
@@ -164,6 +181,7 @@ void run_instructions(Grid& grid, const std::vector<Instruction> instructions) {
                 while (curr_low_z <= instruction.z2 && y_slice.slices.contains(curr_low_z)) {
                     Region& region {y_slice.slices.at(curr_low_z)};
                     region.on = instruction.state;
+                    AOC_TRACE_ADD("regions_written", 1);
 
                     curr_low_z = region.z_max + 1;
                 }
@@ -198,20 +216,83 @@ long count_on(const Grid& grid) {
     return count;
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     std::vector<Instruction> instructions {};
     Instruction instruction;
-    while (std::cin >> instruction) {
+    while (in >> instruction) {
         instructions.push_back(instruction);
     }
 
+    AOC_TRACE_NEXT_PHASE("build");
     Grid grid {};
     slice_x_bounds(grid, instructions);
     slice_y_bounds(grid, instructions);
     slice_z_bounds(grid, instructions);
+    AOC_TRACE_NEXT_PHASE("solve");
     run_instructions(grid, instructions);
 
-    std::cout << count_on(grid) << '\n';
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(count_on(grid));
+}
+
+std::string solve_signed(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    std::vector<day22::Step> steps {day22::parse_steps(input)};
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    long lit {day22::lit_volume_signed(steps)};
+
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(lit);
+}
+
+std::string solve_sweep(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    std::vector<day22::Step> steps {day22::parse_steps(input)};
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    long lit {day22::lit_volume_sweep(steps, aoc::ThreadPool::default_threads())};
+
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(lit);
+}
+
+std::string solve_bit_grid(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    std::vector<day22::Step> steps {day22::parse_steps(input)};
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    long lit {day22::lit_volume_bit_grid(steps, aoc::ThreadPool::default_threads())};
 
-    return 0;
-}
\ No newline at end of file
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(lit);
+}
+
+/* Not an answer but a report: the lit volume after each step, one per
+ * line; the last is the answer. */
+std::string solve_series(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    std::vector<day22::Step> steps {day22::parse_steps(input)};
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    std::vector<long> series {day22::lit_volume_series(steps)};
+
+    AOC_TRACE_NEXT_PHASE("output");
+    std::string out {};
+    for (long lit : series)
+        out += std::to_string(lit) + '\n';
+    if (!out.empty())
+        out.pop_back();
+    return out;
+}
+
+AOC_REGISTER_SOLVER(22, 2, "reference", solve);
+AOC_REGISTER_SOLVER(22, 2, "signed", solve_signed);
+AOC_REGISTER_SOLVER(22, 2, "sweep", solve_sweep);
+AOC_REGISTER_SOLVER(22, 2, "bitgrid", solve_bit_grid);
+AOC_REGISTER_REPORT(22, 2, "series", solve_series);
+
+}
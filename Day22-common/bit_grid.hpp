@@ -0,0 +1,174 @@
+#pragma once
+
+/* The lit volume on a dense grid of bits, for the "bitgrid" engine.
+ *
+ * Every step's bounds on each axis are gathered into one sorted array per
+ * axis, and the cells between consecutive bounds are never split by any step.
+ * A cell is one bit: for each x slab and y row there is a row of bits over
+ * the z cells, so a step sets or clears the same run of bits in each of its
+ * rows, a word at a time. The lit volume of a row is the z length of its
+ * runs of set bits, found from where the runs start and end, times the
+ * row's x and y widths.
+ *
+ * No cell depends on another, so each thread takes its own x slabs and runs
+ * every step over just those. The grid is cubic in the number of steps, so
+ * this is for inputs of about puzzle size. */
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../common/thread_pool.hpp"
+#include "../common/trace.hpp"
+#include "reboot.hpp"
+
+namespace day22 {
+
+class BitGrid {
+private:
+    /* Cell k on an axis runs from bounds[k] to bounds[k + 1]. */
+    std::vector<int> xs {};
+    std::vector<int> ys {};
+    std::vector<int> zs {};
+    size_t row_words {0};
+    std::vector<std::uint64_t> bits {}; // Row (x, y) starts at (x * ny + y) * row_words.
+
+    static constexpr size_t max_words {size_t {1} << 27}; // 1 GiB.
+
+    static std::vector<int> bounds_of(const std::vector<Step>& steps, int Cuboid::*low, int Cuboid::*high) {
+        std::vector<int> bounds {};
+        for (const Step& step : steps) {
+            bounds.push_back(step.cuboid.*low);
+            bounds.push_back(step.cuboid.*high + 1);
+        }
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+        return bounds;
+    }
+
+    static int cell_of(const std::vector<int>& bounds, int coordinate) {
+        return static_cast<int>(std::lower_bound(bounds.begin(), bounds.end(), coordinate) - bounds.begin());
+    }
+
+    int nx() const { return static_cast<int>(xs.size()) - 1; }
+    int ny() const { return static_cast<int>(ys.size()) - 1; }
+    int nz() const { return static_cast<int>(zs.size()) - 1; }
+
+    std::uint64_t* row(int x, int y) {
+        return bits.data() + (static_cast<size_t>(x) * ny() + y) * row_words;
+    }
+
+    /* Sets or clears bits [first, last) of a row. */
+    static void fill(std::uint64_t* words, int first, int last, bool on) {
+        int first_word {first / 64};
+        int last_word {(last - 1) / 64};
+        for (int w {first_word}; w <= last_word; w++) {
+            std::uint64_t mask {~std::uint64_t {0}};
+            if (w == first_word)
+                mask &= ~std::uint64_t {0} << (first % 64);
+            if (w == last_word && last % 64 != 0)
+                mask &= ~std::uint64_t {0} >> (64 - last % 64);
+            words[w] = on ? words[w] | mask : words[w] & ~mask;
+        }
+    }
+
+    /* The z length of the set bits of a row. A run of set bits starting at
+     * cell a and ending before cell b is zs[b] - zs[a] long. */
+    long lit_length(const std::uint64_t* words) const {
+        long length {0};
+        std::uint64_t carry {0}; // The last bit of the previous word.
+        for (size_t w {0}; w < row_words; w++) {
+            std::uint64_t shifted {(words[w] << 1) | carry};
+            std::uint64_t starts {words[w] & ~shifted};
+            std::uint64_t ends {~words[w] & shifted};
+            int base {static_cast<int>(64 * w)};
+            for (; starts != 0; starts &= starts - 1)
+                length -= zs[base + std::countr_zero(starts)];
+            for (; ends != 0; ends &= ends - 1)
+                length += zs[base + std::countr_zero(ends)];
+            carry = words[w] >> 63;
+        }
+        if (carry != 0)
+            length += zs[64 * row_words]; // A run reaching the last word's end.
+        return length;
+    }
+
+public:
+    explicit BitGrid(const std::vector<Step>& steps)
+        : xs {bounds_of(steps, &Cuboid::x1, &Cuboid::x2)},
+          ys {bounds_of(steps, &Cuboid::y1, &Cuboid::y2)},
+          zs {bounds_of(steps, &Cuboid::z1, &Cuboid::z2)} {
+        if (steps.empty())
+            return;
+
+        row_words = (nz() + 63) / 64;
+        size_t words {static_cast<size_t>(nx()) * ny() * row_words};
+        if (words > max_words)
+            throw std::length_error("bit grid of " + std::to_string(nx()) + "x" + std::to_string(ny()) + "x" + std::to_string(nz()) + " cells is too large");
+        AOC_TRACE_COUNTER("grid_words", words);
+
+        /* Bits past nz() stay clear; lit_length() reads zs up to 64 * row_words. */
+        zs.resize(64 * row_words + 1, zs.back());
+        bits.assign(words, 0);
+    }
+
+    /* Runs every step over x slabs [first, last). */
+    void run(const std::vector<Step>& steps, int first, int last) {
+        for (const Step& step : steps) {
+            const Cuboid& c {step.cuboid};
+            int x_lo {std::max(first, cell_of(xs, c.x1))};
+            int x_hi {std::min(last, cell_of(xs, c.x2 + 1))};
+            int y_lo {cell_of(ys, c.y1)};
+            int y_hi {cell_of(ys, c.y2 + 1)};
+            int z_lo {cell_of(zs, c.z1)};
+            int z_hi {cell_of(zs, c.z2 + 1)};
+
+            for (int x {x_lo}; x < x_hi; x++) {
+                for (int y {y_lo}; y < y_hi; y++)
+                    fill(row(x, y), z_lo, z_hi, step.on);
+            }
+        }
+    }
+
+    /* The lit volume of x slabs [first, last). */
+    long lit_volume(int first, int last) {
+        long volume {0};
+        for (int x {first}; x < last; x++) {
+            long area {0};
+            for (int y {0}; y < ny(); y++)
+                area += lit_length(row(x, y)) * (static_cast<long>(ys[y + 1]) - ys[y]);
+            volume += area * (static_cast<long>(xs[x + 1]) - xs[x]);
+        }
+        return volume;
+    }
+
+    int slabs() const { return std::max(nx(), 0); }
+};
+
+inline long lit_volume_bit_grid(const std::vector<Step>& steps, unsigned threads) {
+    AOC_TRACE_SCOPE("bit_grid");
+    BitGrid grid {steps};
+
+    int slabs {grid.slabs()};
+    int runs {std::min(slabs, static_cast<int>(threads))};
+    std::vector<long> run_volume(runs, 0);
+
+    aoc::ThreadPool pool {threads};
+    for (int run {0}; run < runs; run++) {
+        pool.submit([&, run] {
+            int first {static_cast<int>(static_cast<long>(slabs) * run / runs)};
+            int last {static_cast<int>(static_cast<long>(slabs) * (run + 1) / runs)};
+            grid.run(steps, first, last);
+            run_volume[run] = grid.lit_volume(first, last);
+        });
+    }
+    pool.wait();
+
+    return std::accumulate(run_volume.begin(), run_volume.end(), 0L);
+}
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+/* The reboot steps, shared by the Day 22 engines. Cuboids are inclusive on
+ * every axis, as in the puzzle. */
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/input.hpp"
+
+namespace day22 {
+
+struct Cuboid {
+    int x1 {};
+    int x2 {};
+    int y1 {};
+    int y2 {};
+    int z1 {};
+    int z2 {};
+
+    friend bool operator==(const Cuboid& lhs, const Cuboid& rhs) = default;
+};
+
+struct Step {
+    bool on {false};
+    Cuboid cuboid {};
+};
+
+inline bool is_empty(const Cuboid& c) {
+    return c.x1 > c.x2 || c.y1 > c.y2 || c.z1 > c.z2;
+}
+
+inline long volume(const Cuboid& c) {
+    return (static_cast<long>(c.x2) - c.x1 + 1) * (static_cast<long>(c.y2) - c.y1 + 1) * (static_cast<long>(c.z2) - c.z1 + 1);
+}
+
+inline std::vector<Step> parse_steps(std::string_view input) {
+    std::vector<Step> steps {};
+
+    for (std::string_view line : aoc::lines(input)) {
+        if (line.empty())
+            continue;
+
+        Step step {};
+        Cuboid& c {step.cuboid};
+        aoc::Cursor in {line};
+        std::string_view state {};
+        in >> state;
+        step.on = state == "on";
+        in.expect("x=") >> c.x1;
+        in.expect("..") >> c.x2;
+        in.expect(",y=") >> c.y1;
+        in.expect("..") >> c.y2;
+        in.expect(",z=") >> c.z1;
+        in.expect("..") >> c.z2;
+
+        if (!in || (state != "on" && state != "off"))
+            throw std::invalid_argument("bad reboot step: " + std::string {line});
+        if (is_empty(c))
+            throw std::invalid_argument("empty cuboid: " + std::string {line});
+        steps.push_back(step);
+    }
+
+    return steps;
+}
+
+/* Part 1 only considers the cubes in -50..50 on every axis. The cuboid may
+ * come out empty. */
+inline Step clip_to_init_region(Step step) {
+    Cuboid& c {step.cuboid};
+    c = {std::max(c.x1, -50), std::min(c.x2, 50),
+         std::max(c.y1, -50), std::min(c.y2, 50),
+         std::max(c.z1, -50), std::min(c.z2, 50)};
+    return step;
+}
+
+/* Without the steps that miss the region. */
+inline std::vector<Step> clip_to_init_region(const std::vector<Step>& steps) {
+    std::vector<Step> clipped {};
+    for (const Step& step : steps) {
+        Step inside {clip_to_init_region(step)};
+        if (!is_empty(inside.cuboid))
+            clipped.push_back(inside);
+    }
+    return clipped;
+}
+
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+/* The lit volume as a sum of signed cuboids (inclusion-exclusion), for the
+ * "signed" and "series" engines.
+ *
+ * Each cuboid carries a weight, and the lit volume is the sum of weight *
+ * volume. A new step first cancels whatever it overlaps: for every cuboid it
+ * meets, the intersection is added with the opposite weight. An "on" step then
+ * adds itself with weight 1. A cuboid the step covers completely would just be
+ * cancelled by its own negation, so it is dropped in place instead of adding
+ * the pair; pieces that come out identical are merged from time to time, and
+ * merged weights of 0 dropped too. That keeps the list near the number of
+ * distinct pieces rather than doubling with every overlap.
+ *
+ * A step changes the sum by exactly the pieces it adds and drops, so the sum
+ * is kept up to date as they go, and reading the lit volume after every step
+ * costs nothing extra.
+ *
+ * The cuboids live in one array per bound, so the intersection of a step with
+ * every cuboid is one branch-free min / max loop the compiler vectorizes,
+ * leaving a byte per cuboid; only the cuboids it hits are looked at one by
+ * one. */
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include "../common/trace.hpp"
+#include "reboot.hpp"
+
+namespace day22 {
+
+class SignedCuboids {
+private:
+    std::vector<int> x1 {}, x2 {}, y1 {}, y2 {}, z1 {}, z2 {};
+    std::vector<long> weight {};
+
+    /* Whether each cuboid meets the step being applied. */
+    std::vector<std::uint8_t> hits {};
+
+    size_t size_after_merge {0};
+    long lit {0}; // The sum of weight * volume, kept as the steps go.
+
+    void push_back(const Cuboid& c, long w) {
+        x1.push_back(c.x1);
+        x2.push_back(c.x2);
+        y1.push_back(c.y1);
+        y2.push_back(c.y2);
+        z1.push_back(c.z1);
+        z2.push_back(c.z2);
+        weight.push_back(w);
+    }
+
+    void move_entry(size_t from, size_t to) {
+        x1[to] = x1[from];
+        x2[to] = x2[from];
+        y1[to] = y1[from];
+        y2[to] = y2[from];
+        z1[to] = z1[from];
+        z2[to] = z2[from];
+        weight[to] = weight[from];
+    }
+
+    void resize(size_t n) {
+        for (std::vector<int>* bound : {&x1, &x2, &y1, &y2, &z1, &z2})
+            bound->resize(n);
+        weight.resize(n);
+    }
+
+    /* Drops the entries of weight 0, keeping the rest in order. */
+    void drop_zero_weights() {
+        size_t kept {0};
+        for (size_t k {0}; k < weight.size(); k++) {
+            if (weight[k] != 0)
+                move_entry(k, kept++);
+        }
+        resize(kept);
+    }
+
+    /* Sums the weights of identical cuboids into one entry. */
+    void merge_identical() {
+        AOC_TRACE_SCOPE("merge_identical");
+
+        std::vector<size_t> order(weight.size());
+        std::iota(order.begin(), order.end(), 0);
+        auto bounds = [&](size_t k) {
+            return std::tie(x1[k], x2[k], y1[k], y2[k], z1[k], z2[k]);
+        };
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return bounds(a) < bounds(b); });
+
+        for (size_t i {1}; i < order.size(); i++) {
+            if (bounds(order[i]) == bounds(order[i - 1])) {
+                weight[order[i]] += weight[order[i - 1]];
+                weight[order[i - 1]] = 0;
+            }
+        }
+
+        drop_zero_weights();
+        size_after_merge = weight.size();
+    }
+
+public:
+    void apply(const Step& step) {
+        const Cuboid& c {step.cuboid};
+        if (is_empty(c))
+            return; // A part 1 step outside the region.
+        size_t n {weight.size()};
+
+        /* Plain locals, so the byte stores cannot alias any of the inputs. */
+        hits.resize(n);
+        std::uint8_t* hit {hits.data()};
+        const int *ax1 {x1.data()}, *ax2 {x2.data()}, *ay1 {y1.data()}, *ay2 {y2.data()}, *az1 {z1.data()}, *az2 {z2.data()};
+        const int cx1 {c.x1}, cx2 {c.x2}, cy1 {c.y1}, cy2 {c.y2}, cz1 {c.z1}, cz2 {c.z2};
+        for (size_t k {0}; k < n; k++) {
+            hit[k] = (std::max(ax1[k], cx1) <= std::min(ax2[k], cx2))
+                   & (std::max(ay1[k], cy1) <= std::min(ay2[k], cy2))
+                   & (std::max(az1[k], cz1) <= std::min(az2[k], cz2));
+        }
+
+        bool covered_any {false};
+        for (size_t k {0}; k < n; k++) {
+            if (!hits[k])
+                continue;
+
+            Cuboid piece {std::max(x1[k], c.x1), std::min(x2[k], c.x2),
+                          std::max(y1[k], c.y1), std::min(y2[k], c.y2),
+                          std::max(z1[k], c.z1), std::min(z2[k], c.z2)};
+            lit -= weight[k] * volume(piece);
+            if (piece == Cuboid {x1[k], x2[k], y1[k], y2[k], z1[k], z2[k]}) {
+                weight[k] = 0; // Cancelled by its own intersection.
+                covered_any = true;
+            }
+            else
+                push_back(piece, -weight[k]);
+        }
+        AOC_TRACE_ADD("pieces_added", weight.size() - n);
+
+        if (step.on) {
+            push_back(c, 1);
+            lit += volume(c);
+        }
+        if (covered_any)
+            drop_zero_weights();
+        if (weight.size() > 2 * size_after_merge + 64)
+            merge_identical();
+    }
+
+    size_t size() const { return weight.size(); }
+
+    long lit_volume() const { return lit; }
+};
+
+inline long lit_volume_signed(const std::vector<Step>& steps) {
+    SignedCuboids cuboids {};
+    for (const Step& step : steps)
+        cuboids.apply(step);
+    AOC_TRACE_COUNTER("signed_cuboids", cuboids.size());
+    return cuboids.lit_volume();
+}
+
+/* The lit volume after each step. */
+inline std::vector<long> lit_volume_series(const std::vector<Step>& steps) {
+    SignedCuboids cuboids {};
+    std::vector<long> series {};
+    for (const Step& step : steps) {
+        cuboids.apply(step);
+        series.push_back(cuboids.lit_volume());
+    }
+    AOC_TRACE_COUNTER("signed_cuboids", cuboids.size());
+    return series;
+}
+
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+/* The lit volume by sweeping a plane along x, for the "sweep" engine.
+ *
+ * Between two consecutive x boundaries of the steps the plane crosses the
+ * same steps, so the lit volume is the sum over those slabs of slab width
+ * times the lit area of the (y, z) plane there. That area only changes where
+ * a step enters or leaves the plane, and only inside the step's own (y, z)
+ * rectangle, so the sweep carries the area along and, at each boundary,
+ * adds the change inside the rectangle.
+ *
+ * The change comes from a painter's pass over the steps in the plane that
+ * overlap the rectangle, on a grid compressed to their bounds within it. The
+ * steps are painted latest first, and a cell keeps the first step that
+ * reaches it, which is the last one to cover it. Each row keeps, for every
+ * cell, the next cell not painted yet, so a painted cell is never visited
+ * again. Stopping the pass at the entering (or leaving) step gives the area
+ * with it; finishing the pass gives the area without it. The grid is
+ * quadratic in the steps overlapping the rectangle, never cubic.
+ *
+ * The slabs are split into runs, swept on separate threads; each run starts
+ * from one pass over the whole plane. */
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "../common/thread_pool.hpp"
+#include "../common/trace.hpp"
+#include "reboot.hpp"
+
+namespace day22 {
+
+/* The lit area of a (y, z) rectangle, with and without one step that covers
+ * all of it. */
+struct AreaChange {
+    long with {0};
+    long without {0};
+};
+
+class PlanePainter {
+private:
+    std::vector<int> ys {};
+    std::vector<int> zs {};
+    std::vector<int> next_unpainted {}; // Per row, nz + 1 entries.
+
+    int find(int* row, int col) {
+        while (row[col] != col) {
+            row[col] = row[row[col]];
+            col = row[col];
+        }
+        return col;
+    }
+
+public:
+    /* The rectangle is y1..y2, z1..z2, and layers are the indices of the
+     * steps in the plane that overlap it, earliest first. The step split is
+     * the one the change is about; -1 for none, in which case only without
+     * means anything. */
+    AreaChange paint(const std::vector<Step>& steps, const Cuboid& rect, const std::vector<int>& layers, int split) {
+        ys.assign({rect.y1, rect.y2 + 1});
+        zs.assign({rect.z1, rect.z2 + 1});
+        for (int j : layers) {
+            const Cuboid& c {steps[j].cuboid};
+            ys.push_back(std::max(c.y1, rect.y1));
+            ys.push_back(std::min(c.y2, rect.y2) + 1);
+            zs.push_back(std::max(c.z1, rect.z1));
+            zs.push_back(std::min(c.z2, rect.z2) + 1);
+        }
+        for (std::vector<int>* bounds : {&ys, &zs}) {
+            std::sort(bounds->begin(), bounds->end());
+            bounds->erase(std::unique(bounds->begin(), bounds->end()), bounds->end());
+        }
+
+        int ny {static_cast<int>(ys.size()) - 1};
+        int nz {static_cast<int>(zs.size()) - 1};
+        next_unpainted.resize(static_cast<size_t>(ny) * (nz + 1));
+        for (int r {0}; r < ny; r++)
+            std::iota(next_unpainted.begin() + static_cast<size_t>(r) * (nz + 1), next_unpainted.begin() + static_cast<size_t>(r + 1) * (nz + 1), 0);
+        AOC_TRACE_ADD("cells", static_cast<long>(ny) * nz);
+
+        long painted {0};
+        long lit {0};
+        AreaChange change {};
+        bool split_seen {false};
+        auto reach_split = [&] {
+            split_seen = true;
+            long area {(static_cast<long>(rect.y2) - rect.y1 + 1) * (static_cast<long>(rect.z2) - rect.z1 + 1)};
+            change.with = lit + (steps[split].on ? area - painted : 0);
+        };
+
+        for (auto it {layers.rbegin()}; it != layers.rend(); it++) {
+            if (split >= 0 && !split_seen && *it < split)
+                reach_split();
+
+            const Step& step {steps[*it]};
+            const Cuboid& c {step.cuboid};
+            int row_lo {static_cast<int>(std::lower_bound(ys.begin(), ys.end(), std::max(c.y1, rect.y1)) - ys.begin())};
+            int row_hi {static_cast<int>(std::lower_bound(ys.begin(), ys.end(), std::min(c.y2, rect.y2) + 1) - ys.begin())};
+            int col_lo {static_cast<int>(std::lower_bound(zs.begin(), zs.end(), std::max(c.z1, rect.z1)) - zs.begin())};
+            int col_hi {static_cast<int>(std::lower_bound(zs.begin(), zs.end(), std::min(c.z2, rect.z2) + 1) - zs.begin())};
+
+            for (int r {row_lo}; r < row_hi; r++) {
+                int* row {next_unpainted.data() + static_cast<size_t>(r) * (nz + 1)};
+                long height {static_cast<long>(ys[r + 1]) - ys[r]};
+                for (int col {find(row, col_lo)}; col < col_hi; col = find(row, col)) {
+                    long area {height * (zs[col + 1] - zs[col])};
+                    painted += area;
+                    if (step.on)
+                        lit += area;
+                    row[col] = col + 1;
+                }
+            }
+        }
+
+        if (split >= 0 && !split_seen)
+            reach_split();
+        change.without = lit;
+        return change;
+    }
+};
+
+inline long lit_volume_sweep(const std::vector<Step>& steps, unsigned threads) {
+    if (steps.empty())
+        return 0;
+
+    std::vector<int> xs {};
+    for (const Step& step : steps) {
+        xs.push_back(step.cuboid.x1);
+        xs.push_back(step.cuboid.x2 + 1);
+    }
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+
+    auto x_index = [&](int x) {
+        return static_cast<int>(std::lower_bound(xs.begin(), xs.end(), x) - xs.begin());
+    };
+    std::vector<std::vector<int>> entering(xs.size());
+    std::vector<std::vector<int>> leaving(xs.size());
+    for (int i {0}; i < static_cast<int>(steps.size()); i++) {
+        entering[x_index(steps[i].cuboid.x1)].push_back(i);
+        leaving[x_index(steps[i].cuboid.x2 + 1)].push_back(i);
+    }
+
+    Cuboid plane {0, 0, steps[0].cuboid.y1, steps[0].cuboid.y2, steps[0].cuboid.z1, steps[0].cuboid.z2};
+    for (const Step& step : steps) {
+        plane.y1 = std::min(plane.y1, step.cuboid.y1);
+        plane.y2 = std::max(plane.y2, step.cuboid.y2);
+        plane.z1 = std::min(plane.z1, step.cuboid.z1);
+        plane.z2 = std::max(plane.z2, step.cuboid.z2);
+    }
+
+    /* Slabs [first, last) are swept by one job; slab s runs from xs[s] to
+     * xs[s + 1]. */
+    int slabs {static_cast<int>(xs.size()) - 1};
+    int runs {std::min(slabs, static_cast<int>(4 * threads))};
+    std::vector<long> run_volume(runs, 0);
+
+    auto sweep_run = [&](int run) {
+        int first {static_cast<int>(static_cast<long>(slabs) * run / runs)};
+        int last {static_cast<int>(static_cast<long>(slabs) * (run + 1) / runs)};
+        PlanePainter painter {};
+
+        /* The steps in the plane, earliest first. */
+        std::vector<int> in_plane {};
+        for (int i {0}; i < static_cast<int>(steps.size()); i++) {
+            if (steps[i].cuboid.x1 <= xs[first] && xs[first] <= steps[i].cuboid.x2)
+                in_plane.push_back(i);
+        }
+        long area {painter.paint(steps, plane, in_plane, -1).without};
+        long volume {area * (static_cast<long>(xs[first + 1]) - xs[first])};
+
+        std::vector<int> layers {};
+        auto change_at = [&](int split) {
+            const Cuboid& rect {steps[split].cuboid};
+            layers.clear();
+            for (int j : in_plane) {
+                const Cuboid& c {steps[j].cuboid};
+                if (j != split && c.y1 <= rect.y2 && rect.y1 <= c.y2 && c.z1 <= rect.z2 && rect.z1 <= c.z2)
+                    layers.push_back(j);
+            }
+            return painter.paint(steps, rect, layers, split);
+        };
+
+        for (int s {first + 1}; s < last; s++) {
+            for (int i : leaving[s]) {
+                AreaChange change {change_at(i)};
+                area += change.without - change.with;
+                in_plane.erase(std::lower_bound(in_plane.begin(), in_plane.end(), i));
+            }
+            for (int i : entering[s]) {
+                AreaChange change {change_at(i)};
+                area += change.with - change.without;
+                in_plane.insert(std::lower_bound(in_plane.begin(), in_plane.end(), i), i);
+            }
+            volume += area * (static_cast<long>(xs[s + 1]) - xs[s]);
+        }
+
+        run_volume[run] = volume;
+    };
+
+    aoc::ThreadPool pool {threads};
+    for (int run {0}; run < runs; run++)
+        pool.submit([&, run] { sweep_run(run); });
+    pool.wait();
+
+    return std::accumulate(run_volume.begin(), run_volume.end(), 0L);
+}
+
+}
@@ -5,7 +5,16 @@
 #include <map>
 #include <vector>
 
-/* The input has been updated manually. */
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+#include "../Day23-common/astar.hpp"
+#include "../Day23-common/burrow.hpp"
+#include "../Day23-common/parallel_search.hpp"
+
+namespace day23_part2 {
+
+/* The two extra rows are added by day23::unfold_diagram(). */
 
 constexpr std::array<int, 7> SPOTS {0, 1, 3, 5, 7, 9, 10};
 
@@ -244,20 +253,21 @@ public:
         return output;
     }
 };
-std::map<State, int> memo_map {};
-int find_lowest_cost_from(const State& state) {
+
+int find_lowest_cost_from(const State& state, std::map<State, int>& memo_map) {
     if (state.is_done())
         return 0;
 
     if (memo_map.contains(state))
         return memo_map.at(state);
 
+    AOC_TRACE_ADD("states_expanded", 1);
     auto states {state.next_states()};
 
     int min_cost {INT32_MAX};
     for (const auto& [s, cost] : states) {
         
-        int rest_cost {find_lowest_cost_from(s)};
+        int rest_cost {find_lowest_cost_from(s, memo_map)};
 
         if (rest_cost == -1)
             continue;
@@ -276,11 +286,15 @@ int find_lowest_cost_from(const State& state) {
     return min_cost;
 }
 
-int main() {
-    std::string str {};
+std::string solve(std::string_view input_text) {
+    AOC_TRACE_PHASES("parse");
+    std::string unfolded {day23::unfold_diagram(input_text)};
+    aoc::Cursor in {unfolded};
+
+    std::string_view str {};
     char ch {};
-    std::array<char, 16> input;
-    std::cin >> str 
+    std::array<char, 16> input {};
+    in >> str 
              >> str
              >> ch >> ch >> ch >> input[0] >> ch >> input[1] >> ch >> input[2] >> ch >> input[3] >> str
              >> ch >> input[4] >> ch >> input[5] >> ch >> input[6] >> ch >> input[7] >> str
@@ -290,7 +304,58 @@ int main() {
     State state {};
     state.init(input);
 
-    std::cout << find_lowest_cost_from(state) << '\n';
+    AOC_TRACE_NEXT_PHASE("solve");
+    std::map<State, int> memo_map {};
+    int lowest_cost {find_lowest_cost_from(state, memo_map)};
+    AOC_TRACE_COUNTER("memo_states", memo_map.size());
+
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(lowest_cost);
+}
+
+AOC_REGISTER_SOLVER(23, 2, "reference", solve);
+
+/* The same search on packed states (see Day23-common/burrow.hpp). */
+std::string solve_packed(std::string_view input_text) {
+    AOC_TRACE_PHASES("parse");
+    day23::Diagram diagram {day23::parse_diagram(day23::unfold_diagram(input_text))};
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    long lowest_cost {day23::with_burrow(diagram, [&]<typename B>(B) { return day23::lowest_cost_memoized<B>(diagram); })};
+
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(lowest_cost);
+}
+
+AOC_REGISTER_SOLVER(23, 2, "packed", solve_packed);
+
+/* Best-first instead, stopping at the goal (see Day23-common/astar.hpp). */
+std::string solve_astar(std::string_view input_text) {
+    AOC_TRACE_PHASES("parse");
+    day23::Diagram diagram {day23::parse_diagram(day23::unfold_diagram(input_text))};
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    long lowest_cost {day23::with_burrow(diagram, [&]<typename B>(B) { return day23::lowest_cost_astar<B>(diagram); })};
+
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(lowest_cost);
+}
+
+AOC_REGISTER_SOLVER(23, 2, "astar", solve_astar);
+
+/* The same search with each cost bucket expanded across threads (see
+ * Day23-common/parallel_search.hpp). */
+std::string solve_parallel(std::string_view input_text) {
+    AOC_TRACE_PHASES("parse");
+    day23::Diagram diagram {day23::parse_diagram(day23::unfold_diagram(input_text))};
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    long lowest_cost {day23::with_burrow(diagram, [&]<typename B>(B) { return day23::lowest_cost_parallel<B>(diagram, aoc::ThreadPool::default_threads()); })};
+
+    AOC_TRACE_NEXT_PHASE("output");
+    return std::to_string(lowest_cost);
+}
+
+AOC_REGISTER_SOLVER(23, 2, "parallel", solve_parallel);
 
-    return 0;
 }
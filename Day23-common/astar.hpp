@@ -0,0 +1,108 @@
+#pragma once
+
+/* Best-first search for the least energy, for the "astar" engine.
+ *
+ * States leave the queue in order of energy spent so far plus a lower bound
+ * on the energy still needed, so the first time the goal leaves the queue
+ * its energy is the least possible, and states costing more than that are
+ * never expanded. The bound charges every amphipod that is not yet settled
+ * (in its own room, with only its own type behind it) the steps to the
+ * hallway, along it to its room's door and one step in, ignoring everyone
+ * else. An amphipod in the wrong slot of its own room has to step out and
+ * back, two steps along the hallway. The amphipods entering a room fill it
+ * from the back, so on top of that one step in, the k of them still to
+ * enter walk 1 + 2 + ... + (k - 1) further steps. */
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "../common/trace.hpp"
+#include "burrow.hpp"
+
+namespace day23 {
+
+/* Never more than the least energy from state to the goal. */
+template<typename B>
+long lower_bound(const typename B::State& state) {
+    long bound {0};
+    std::array<int, B::rooms> to_enter {};
+
+    for (int s {0}; s < B::spots; s++) {
+        int occupant {state.hallway(s)};
+        if (occupant == 0)
+            continue;
+        int type {occupant - 1};
+        to_enter[type]++;
+        bound += (std::abs(B::spot_x[s] - B::room_x(type)) + 1) * B::energies[type];
+    }
+
+    for (int r {0}; r < B::rooms; r++) {
+        unsigned code {state.room(r)};
+        int count {B::room_count(code)};
+        unsigned type_mask {(1u << B::type_bits) - 1};
+
+        /* From the back (the highest bits) while they belong here. */
+        int settled {0};
+        while (settled < count && ((code >> (B::type_bits * (count - 1 - settled))) & type_mask) == static_cast<unsigned>(r))
+            settled++;
+
+        for (int k {0}; k < count - settled; k++) {
+            int type {static_cast<int>((code >> (B::type_bits * k)) & type_mask)}; // k from the front.
+            int out {B::depth - count + k + 1};
+            int along {type == r ? 2 : std::abs(B::room_x(r) - B::room_x(type))};
+            to_enter[type]++;
+            bound += (out + along + 1) * B::energies[type];
+        }
+    }
+
+    for (int type {0}; type < B::rooms; type++)
+        bound += to_enter[type] * (to_enter[type] - 1) / 2 * B::energies[type];
+    return bound;
+}
+
+/* The least energy from the diagram's starting position to the goal, or -1
+ * if it cannot be reached. */
+template<typename B>
+long lowest_cost_astar(const Diagram& diagram) {
+    using State = typename B::State;
+    using Entry = std::pair<long, typename B::Word>; // Energy plus bound, state.
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue {};
+    StateTable<typename B::Word> best {}; // The least energy found so far to reach each state.
+
+    State start {B::start(diagram)};
+    State goal {B::goal()};
+    best.insert_or_assign(start.bits, 0);
+    queue.push({lower_bound<B>(start), start.bits});
+
+    while (!queue.empty()) {
+        auto [estimate, bits] {queue.top()};
+        queue.pop();
+
+        State state {bits};
+        long spent {*best.find(state.bits)};
+        if (estimate != spent + lower_bound<B>(state))
+            continue; // Reached more cheaply since it was queued.
+        if (state == goal) {
+            AOC_TRACE_COUNTER("states_seen", best.size());
+            return spent;
+        }
+
+        AOC_TRACE_ADD("states_expanded", 1);
+        B::for_each_move(state, [&](const State& next, long cost) {
+            const long* known {best.find(next.bits)};
+            if (known == nullptr || spent + cost < *known) {
+                best.insert_or_assign(next.bits, spent + cost);
+                queue.push({spent + cost + lower_bound<B>(next), next.bits});
+            }
+        });
+    }
+
+    return -1;
+}
+
+}
@@ -0,0 +1,479 @@
+#pragma once
+
+/* The burrow packed into one integer, for the faster Day 23 engines.
+ *
+ * Everything about the burrow's shape is a template parameter: Depth is how
+ * many amphipods a room holds and Rooms is how many rooms (and types of
+ * amphipod) there are. The puzzle has 4 rooms, of depth 2 in part 1 and 4 in
+ * part 2. The hallway is 2 * Rooms + 3 long, with the rooms' doors at
+ * x = 2, 4, ... and a spot to stop on everywhere else.
+ *
+ * Each hallway spot takes enough bits for 0 (empty) or 1 + a type (A = 0).
+ * Each room is a stack, filled from the back and left from the front, so it
+ * is kept as one: a 1 bit, then the types from the back of the room to the
+ * front. Pushing and popping the front amphipod are shifts, and the number in
+ * the room is where the 1 bit is. For 4 rooms of depth 4 that is 7 * 3 + 4 *
+ * 9 = 57 bits, so a state compares, hashes and copies as a single 64-bit
+ * integer; bigger burrows up to 128 bits use __uint128_t.
+ *
+ * Moves follow the puzzle's rules as the reference solver applies them: out
+ * of a room to a hallway spot, or straight into the amphipod's own room when
+ * it holds no strangers and the hallway is clear; from the hallway only into
+ * its own room. Amphipods in a room holding only their own type never leave.
+ * Moves are written into a fixed-size buffer and made and undone in place;
+ * whether the hallway blocks one is a single AND with a path mask from a
+ * table built at compile time. */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "../common/hash.hpp"
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+
+namespace day23 {
+
+constexpr int max_rooms {6};
+constexpr int max_depth {8};
+
+/* The amphipods of each room, front to back, read from the puzzle diagram. */
+struct Diagram {
+    int depth {0};
+    int rooms {0};
+    std::array<std::array<int, max_depth>, max_rooms> types {};
+};
+
+inline Diagram parse_diagram(std::string_view input) {
+    Diagram diagram {};
+    for (std::string_view line : aoc::lines(input)) {
+        if (line.find_first_of("ABCDEFGH") == std::string_view::npos)
+            continue;
+        if (diagram.depth == max_depth)
+            throw std::invalid_argument("rooms deeper than " + std::to_string(max_depth));
+
+        int rooms {0};
+        while (3 + 2 * rooms < static_cast<int>(line.size()) && line[3 + 2 * rooms] >= 'A' && line[3 + 2 * rooms] <= 'Z') {
+            if (rooms == max_rooms)
+                throw std::invalid_argument("more than " + std::to_string(max_rooms) + " rooms");
+            diagram.types[rooms][diagram.depth] = line[3 + 2 * rooms] - 'A';
+            rooms++;
+        }
+        if (rooms == 0 || (diagram.rooms != 0 && rooms != diagram.rooms))
+            throw std::invalid_argument("bad room row: " + std::string {line});
+        diagram.rooms = rooms;
+        diagram.depth++;
+    }
+
+    if (diagram.depth == 0)
+        throw std::invalid_argument("no rooms in the diagram");
+
+    std::array<int, max_rooms> seen {};
+    for (int r {0}; r < diagram.rooms; r++) {
+        for (int row {0}; row < diagram.depth; row++) {
+            int type {diagram.types[r][row]};
+            if (type >= diagram.rooms)
+                throw std::invalid_argument("an amphipod with no room of its own");
+            seen[type]++;
+        }
+    }
+    for (int r {0}; r < diagram.rooms; r++) {
+        if (seen[r] != diagram.depth)
+            throw std::invalid_argument("each type must fill one room exactly");
+    }
+    return diagram;
+}
+
+/* Part 2 unfolds the diagram: two more rows go between the two given. Those
+ * rows are only defined for 4 rooms, so a wider diagram of two rows is
+ * refused; any diagram with more rows (already unfolded, say) is left
+ * alone. */
+inline std::string unfold_diagram(std::string_view input) {
+    Diagram given {parse_diagram(input)};
+    if (given.depth != 2)
+        return std::string {input};
+    if (given.rooms != 4)
+        throw std::invalid_argument("part 2 only unfolds diagrams of 4 rooms, not " + std::to_string(given.rooms) + "; give the rooms in full instead");
+
+    std::string unfolded {};
+    bool inserted {false};
+    for (std::string_view line : aoc::lines(input)) {
+        unfolded.append(line).push_back('\n');
+        if (!inserted && line.find_first_of("ABCD") != std::string_view::npos) {
+            unfolded += "  #D#C#B#A#\n  #D#B#A#C#\n";
+            inserted = true;
+        }
+    }
+    return unfolded;
+}
+
+/* One amphipod of the given type going from one place to another: a place
+ * is a hallway spot, or spots + r for room r. */
+struct Move {
+    std::uint8_t from {};
+    std::uint8_t to {};
+    std::uint8_t type {};
+    long cost {};
+};
+
+template<int Depth, int Rooms>
+class Burrow {
+public:
+    static constexpr int depth {Depth};
+    static constexpr int rooms {Rooms};
+    static constexpr int spots {Rooms + 3};
+
+    static constexpr int type_bits {std::bit_width(static_cast<unsigned>(Rooms - 1))};
+    static constexpr int spot_bits {std::bit_width(static_cast<unsigned>(Rooms))};
+    static constexpr int room_bits {type_bits * Depth + 1};
+    static constexpr int room_shift {spot_bits * spots};
+    static constexpr int state_bits {room_shift + room_bits * Rooms};
+
+    /* Whether a state fits the widest integer there is. */
+    static constexpr bool fits {state_bits <= 128};
+
+    using Word = std::conditional_t<(state_bits <= 64), std::uint64_t, __uint128_t>;
+
+    struct State {
+        Word bits {0};
+
+        /* 0 if the spot is empty, else 1 + the type there. */
+        int hallway(int spot) const {
+            return static_cast<int>(bits >> (spot_bits * spot)) & ((1 << spot_bits) - 1);
+        }
+
+        void set_hallway(int spot, int value) {
+            bits &= ~(Word {(1u << spot_bits) - 1} << (spot_bits * spot));
+            bits |= Word {static_cast<unsigned>(value)} << (spot_bits * spot);
+        }
+
+        unsigned room(int r) const {
+            return static_cast<unsigned>(bits >> (room_shift + room_bits * r)) & ((1u << room_bits) - 1);
+        }
+
+        void set_room(int r, unsigned code) {
+            int shift {room_shift + room_bits * r};
+            bits &= ~(Word {(1u << room_bits) - 1} << shift);
+            bits |= Word {code} << shift;
+        }
+
+        friend bool operator==(const State& lhs, const State& rhs) = default;
+    };
+
+    /* Every amphipod in the hallway home, or each room's front amphipod to
+     * each spot. */
+    static constexpr int max_moves {spots + Rooms * spots};
+    using MoveBuffer = std::array<Move, max_moves>;
+
+    static constexpr std::array<long, Rooms> energies {[] {
+        std::array<long, Rooms> energy {};
+        for (long type {0}, e {1}; type < Rooms; type++, e *= 10)
+            energy[type] = e;
+        return energy;
+    }()};
+
+    static constexpr int room_x(int r) { return 2 * (r + 1); }
+    static constexpr int room_place(int r) { return spots + r; }
+
+    /* Spots 0 and 1 are left of the first door, one spot follows each door. */
+    static constexpr std::array<int, spots> spot_x {[] {
+        std::array<int, spots> x {0, 1};
+        for (int r {0}; r < Rooms; r++)
+            x[r + 2] = room_x(r) + 1;
+        x[spots - 1] = room_x(Rooms - 1) + 2;
+        return x;
+    }()};
+
+    /* The spots strictly between the door of room r and spot s, and s itself:
+     * they must all be empty to go from the room to the spot. */
+    static constexpr std::array<std::array<std::uint16_t, spots>, Rooms> spot_paths {[] {
+        std::array<std::array<std::uint16_t, spots>, Rooms> paths {};
+        for (int r {0}; r < Rooms; r++) {
+            for (int s {0}; s < spots; s++) {
+                int lo {std::min(room_x(r), spot_x[s])};
+                int hi {std::max(room_x(r), spot_x[s])};
+                for (int between {0}; between < spots; between++) {
+                    if (spot_x[between] >= lo && spot_x[between] <= hi)
+                        paths[r][s] |= 1 << between;
+                }
+            }
+        }
+        return paths;
+    }()};
+
+    /* The spots between the doors of two rooms. */
+    static constexpr std::array<std::array<std::uint16_t, Rooms>, Rooms> room_paths {[] {
+        std::array<std::array<std::uint16_t, Rooms>, Rooms> paths {};
+        for (int a {0}; a < Rooms; a++) {
+            for (int b {0}; b < Rooms; b++) {
+                for (int s {0}; s < spots; s++) {
+                    if (spot_x[s] > std::min(room_x(a), room_x(b)) && spot_x[s] < std::max(room_x(a), room_x(b)))
+                        paths[a][b] |= 1 << s;
+                }
+            }
+        }
+        return paths;
+    }()};
+
+    /* A room code: 1, then the types from the back to the front. */
+    static constexpr int room_count(unsigned code) { return (std::bit_width(code) - 1) / type_bits; }
+    static constexpr int room_front(unsigned code) { return code & ((1u << type_bits) - 1); }
+    static constexpr unsigned room_pop(unsigned code) { return code >> type_bits; }
+    static constexpr unsigned room_push(unsigned code, int type) { return (code << type_bits) | type; }
+
+    /* clean_rooms[r][n] is room r holding n amphipods, all of type r. */
+    static constexpr std::array<std::array<unsigned, Depth + 1>, Rooms> clean_rooms {[] {
+        std::array<std::array<unsigned, Depth + 1>, Rooms> codes {};
+        for (int r {0}; r < Rooms; r++) {
+            codes[r][0] = 1;
+            for (int n {1}; n <= Depth; n++)
+                codes[r][n] = room_push(codes[r][n - 1], r);
+        }
+        return codes;
+    }()};
+
+    /* Whether every amphipod in room r (if any) is of type r. */
+    static constexpr bool room_clean(unsigned code, int r) {
+        return code == clean_rooms[r][room_count(code)];
+    }
+
+    static State start(const Diagram& diagram) {
+        State state {};
+        for (int r {0}; r < Rooms; r++) {
+            unsigned code {1};
+            for (int row {Depth - 1}; row >= 0; row--)
+                code = room_push(code, diagram.types[r][row]);
+            state.set_room(r, code);
+        }
+        return state;
+    }
+
+    static State goal() {
+        State state {};
+        for (int r {0}; r < Rooms; r++)
+            state.set_room(r, clean_rooms[r][Depth]);
+        return state;
+    }
+
+    /* Bit s set if hallway spot s is taken. */
+    static unsigned occupied(const State& state) {
+        unsigned mask {0};
+        for (int s {0}; s < spots; s++)
+            mask |= static_cast<unsigned>(state.hallway(s) != 0) << s;
+        return mask;
+    }
+
+    /* Writes every move from state into moves and returns how many. */
+    static int generate(const State& state, MoveBuffer& moves) {
+        int count {0};
+        unsigned taken {occupied(state)};
+
+        /* From the hallway into the amphipod's own room. */
+        for (unsigned left {taken}; left != 0; left &= left - 1) {
+            int s {std::countr_zero(left)};
+            int type {state.hallway(s) - 1};
+            unsigned home {state.room(type)};
+            if (!room_clean(home, type) || (taken & spot_paths[type][s] & ~(1u << s)) != 0)
+                continue;
+
+            int steps {std::abs(spot_x[s] - room_x(type)) + Depth - room_count(home)};
+            moves[count++] = {static_cast<std::uint8_t>(s), static_cast<std::uint8_t>(room_place(type)),
+                              static_cast<std::uint8_t>(type), steps * energies[type]};
+        }
+
+        /* Out of a room with strangers in it: home if it can, else into the
+         * hallway. */
+        for (int r {0}; r < Rooms; r++) {
+            unsigned code {state.room(r)};
+            if (room_clean(code, r))
+                continue;
+
+            int type {room_front(code)};
+            int out {Depth - room_count(code) + 1}; // Steps up to the hallway.
+
+            unsigned home {state.room(type)};
+            if (room_clean(home, type) && (taken & room_paths[r][type]) == 0) {
+                int steps {out + std::abs(room_x(r) - room_x(type)) + Depth - room_count(home)};
+                moves[count++] = {static_cast<std::uint8_t>(room_place(r)), static_cast<std::uint8_t>(room_place(type)),
+                                  static_cast<std::uint8_t>(type), steps * energies[type]};
+                continue;
+            }
+
+            for (int s {0}; s < spots; s++) {
+                if ((taken & spot_paths[r][s]) == 0) {
+                    moves[count++] = {static_cast<std::uint8_t>(room_place(r)), static_cast<std::uint8_t>(s),
+                                      static_cast<std::uint8_t>(type), (out + std::abs(room_x(r) - spot_x[s])) * energies[type]};
+                }
+            }
+        }
+
+        return count;
+    }
+
+    static void take(State& state, int place) {
+        if (place < spots)
+            state.set_hallway(place, 0);
+        else
+            state.set_room(place - spots, room_pop(state.room(place - spots)));
+    }
+
+    static void put(State& state, int place, int type) {
+        if (place < spots)
+            state.set_hallway(place, type + 1);
+        else
+            state.set_room(place - spots, room_push(state.room(place - spots), type));
+    }
+
+    static void apply(State& state, const Move& move) {
+        take(state, move.from);
+        put(state, move.to, move.type);
+    }
+
+    static void undo(State& state, const Move& move) {
+        take(state, move.to);
+        put(state, move.from, move.type);
+    }
+
+    /* Calls visit(next, cost) for every state one move away. */
+    template<typename Visit>
+    static void for_each_move(const State& state, Visit visit) {
+        MoveBuffer moves;
+        int count {generate(state, moves)};
+        State next {state};
+        for (int i {0}; i < count; i++) {
+            apply(next, moves[i]);
+            visit(static_cast<const State&>(next), moves[i].cost);
+            undo(next, moves[i]);
+        }
+    }
+};
+
+static_assert(Burrow<4, 4>::state_bits == 57 && std::is_same_v<Burrow<4, 4>::Word, std::uint64_t>);
+static_assert(Burrow<2, 4>::spot_x == std::array<int, 7> {0, 1, 3, 5, 7, 9, 10});
+static_assert(Burrow<2, 4>::spot_paths[0][0] == 0b0000011 && Burrow<2, 4>::spot_paths[1][6] == 0b1111000);
+static_assert(Burrow<2, 4>::room_paths[0][3] == 0b0011100 && Burrow<2, 4>::room_paths[2][2] == 0);
+
+/* Calls f(Burrow<depth, rooms> {}) for the diagram's shape; every supported
+ * shape is its own instantiation. */
+template<int Rooms = 4, int Depth = 1, typename F>
+long with_burrow(const Diagram& diagram, F f) {
+    if constexpr (Rooms > max_rooms)
+        throw std::invalid_argument("no burrow with " + std::to_string(diagram.rooms) + " rooms of depth " + std::to_string(diagram.depth));
+    else if constexpr (Depth > max_depth || !Burrow<std::min(Depth, max_depth), Rooms>::fits)
+        return with_burrow<Rooms + 1, 1>(diagram, f);
+    else if (diagram.rooms == Rooms && diagram.depth == Depth)
+        return f(Burrow<Depth, Rooms> {});
+    else
+        return with_burrow<Rooms, Depth + 1>(diagram, f);
+}
+
+/* A packed state mixed down to 64 bits, every bit of it reaching every bit
+ * of the hash. Tables take their slots from the low bits; ShardedStateTable
+ * picks a shard from the top ones. */
+template<typename Word>
+std::uint64_t hash_state(Word key) {
+    std::uint64_t folded {static_cast<std::uint64_t>(key)};
+    if constexpr (sizeof(Word) > sizeof(std::uint64_t))
+        folded ^= aoc::mix_hash(static_cast<std::uint64_t>(key >> 64));
+    return aoc::mix_hash(folded);
+}
+
+/* Packed states to a long, open addressed and at most half full. The key 0
+ * is free to mark empty slots, since every room code has its 1 bit. */
+template<typename Word>
+class StateTable {
+private:
+    std::vector<Word> keys {};
+    std::vector<long> values {};
+    size_t used {0};
+
+    size_t slot_of(Word key) const {
+        size_t mask {keys.size() - 1};
+        size_t slot {static_cast<size_t>(hash_state(key)) & mask};
+        while (keys[slot] != 0 && keys[slot] != key)
+            slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void rehash(size_t size) {
+        std::vector<Word> old_keys(size, 0);
+        std::vector<long> old_values(size, 0);
+        old_keys.swap(keys);
+        old_values.swap(values);
+        for (size_t i {0}; i < old_keys.size(); i++) {
+            if (old_keys[i] != 0) {
+                size_t slot {slot_of(old_keys[i])};
+                keys[slot] = old_keys[i];
+                values[slot] = old_values[i];
+            }
+        }
+    }
+
+public:
+    explicit StateTable(size_t capacity = 1 << 12) : keys(std::bit_ceil(2 * capacity), 0), values(keys.size(), 0) {}
+
+    /* The value for key, or nullptr. */
+    const long* find(Word key) const {
+        size_t slot {slot_of(key)};
+        return keys[slot] == key ? &values[slot] : nullptr;
+    }
+
+    void insert_or_assign(Word key, long value) {
+        if (2 * (used + 1) > keys.size())
+            rehash(2 * keys.size());
+
+        size_t slot {slot_of(key)};
+        if (keys[slot] != key) {
+            keys[slot] = key;
+            used++;
+        }
+        values[slot] = value;
+    }
+
+    size_t size() const { return used; }
+};
+
+/* The least energy from state to the goal, or -1 if it cannot be reached,
+ * by the same memoized depth-first search as the reference solver. Moves are
+ * made on state in place and undone on the way back. */
+template<typename B>
+long lowest_cost_from(typename B::State& state, const typename B::State& goal, StateTable<typename B::Word>& memo) {
+    if (state == goal)
+        return 0;
+    if (const long* known {memo.find(state.bits)})
+        return *known;
+
+    AOC_TRACE_ADD("states_expanded", 1);
+    typename B::MoveBuffer moves;
+    int count {B::generate(state, moves)};
+    long min_cost {-1};
+    for (int i {0}; i < count; i++) {
+        B::apply(state, moves[i]);
+        long rest {lowest_cost_from<B>(state, goal, memo)};
+        B::undo(state, moves[i]);
+        if (rest != -1 && (min_cost == -1 || moves[i].cost + rest < min_cost))
+            min_cost = moves[i].cost + rest;
+    }
+
+    memo.insert_or_assign(state.bits, min_cost);
+    return min_cost;
+}
+
+/* The same, from the diagram's starting position. */
+template<typename B>
+long lowest_cost_memoized(const Diagram& diagram) {
+    StateTable<typename B::Word> memo {};
+    typename B::State state {B::start(diagram)};
+    long cost {lowest_cost_from<B>(state, B::goal(), memo)};
+    AOC_TRACE_COUNTER("memo_states", memo.size());
+    return cost;
+}
+
+}
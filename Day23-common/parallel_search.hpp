@@ -0,0 +1,151 @@
+#pragma once
+
+/* Best-first search spread over threads, for the "parallel" engine.
+ *
+ * The states waiting to be expanded are kept in buckets by energy spent plus
+ * lower_bound(). The bound never drops by more than a move costs, so a move
+ * never leads to a smaller estimate than the state it starts from. The
+ * buckets are taken smallest first, like states from the queue of the
+ * "astar" engine. Every state in a bucket is expanded at once, in chunks on
+ * the thread pool. A move that keeps the estimate goes back into the bucket
+ * being worked on, which is taken again before any larger one. Once the
+ * bucket with the goal's energy is reached, nothing smaller is left, so the
+ * goal's energy is the least possible. The threads change only which states
+ * get expanded, and the answer is the same for any number of them.
+ *
+ * The least energy to each state is kept in a table split into shards by the
+ * top bits of the state's hash, each with its own lock, so threads relaxing
+ * different states seldom wait on each other. */
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "../common/thread_pool.hpp"
+#include "../common/trace.hpp"
+#include "astar.hpp"
+#include "burrow.hpp"
+
+namespace day23 {
+
+/* A StateTable that threads can share. */
+template<typename Word>
+class ShardedStateTable {
+private:
+    static constexpr int shard_bits {6};
+
+    struct Shard {
+        std::mutex mutex {};
+        StateTable<Word> table {};
+    };
+    std::vector<Shard> shards;
+
+    Shard& shard_of(Word key) {
+        return shards[hash_state(key) >> (64 - shard_bits)];
+    }
+
+public:
+    ShardedStateTable() : shards(size_t {1} << shard_bits) {}
+
+    /* The value for key, or -1. */
+    long find(Word key) {
+        Shard& shard {shard_of(key)};
+        std::lock_guard lock {shard.mutex};
+        const long* value {shard.table.find(key)};
+        return value != nullptr ? *value : -1;
+    }
+
+    /* Stores value for key unless it already has one no larger. Returns
+     * whether it did. */
+    bool lower(Word key, long value) {
+        Shard& shard {shard_of(key)};
+        std::lock_guard lock {shard.mutex};
+        const long* known {shard.table.find(key)};
+        if (known != nullptr && *known <= value)
+            return false;
+        shard.table.insert_or_assign(key, value);
+        return true;
+    }
+
+    size_t size() {
+        size_t total {0};
+        for (Shard& shard : shards) {
+            std::lock_guard lock {shard.mutex};
+            total += shard.table.size();
+        }
+        return total;
+    }
+};
+
+/* The least energy from the diagram's starting position to the goal, or -1
+ * if it cannot be reached. */
+template<typename B>
+long lowest_cost_parallel(const Diagram& diagram, unsigned threads) {
+    using State = typename B::State;
+    using Word = typename B::Word;
+    using Entry = std::pair<long, Word>; // Energy plus bound, state.
+
+    /* Buckets smaller than this are expanded on one thread. */
+    constexpr size_t min_chunk {64};
+
+    ShardedStateTable<Word> best {}; // The least energy found so far to reach each state.
+    std::map<long, std::vector<Word>> buckets {}; // By energy plus bound.
+
+    State start {B::start(diagram)};
+    State goal {B::goal()};
+    best.lower(start.bits, 0);
+    buckets[lower_bound<B>(start)].push_back(start.bits);
+
+    aoc::ThreadPool pool {threads};
+    std::vector<std::vector<Entry>> queued(4 * std::max(threads, 1u)); // Per chunk.
+
+    while (!buckets.empty()) {
+        auto first {buckets.begin()};
+        long estimate {first->first};
+        std::vector<Word> states {std::move(first->second)};
+        buckets.erase(first);
+
+        if (best.find(goal.bits) == estimate) {
+            AOC_TRACE_COUNTER("states_seen", best.size());
+            return estimate;
+        }
+        AOC_TRACE_ADD("buckets", 1);
+
+        auto expand = [&](size_t begin, size_t end, std::vector<Entry>& out) {
+            for (size_t i {begin}; i < end; i++) {
+                State state {states[i]};
+                long spent {best.find(state.bits)};
+                if (estimate != spent + lower_bound<B>(state))
+                    continue; // Reached more cheaply since it was queued.
+
+                AOC_TRACE_ADD("states_expanded", 1);
+                B::for_each_move(state, [&](const State& next, long cost) {
+                    if (best.lower(next.bits, spent + cost))
+                        out.push_back({spent + cost + lower_bound<B>(next), next.bits});
+                });
+            }
+        };
+
+        size_t chunks {std::min(queued.size(), (states.size() + min_chunk - 1) / min_chunk)};
+        if (chunks <= 1)
+            expand(0, states.size(), queued[0]);
+        else {
+            for (size_t c {0}; c < chunks; c++)
+                pool.submit([&, c] { expand(states.size() * c / chunks, states.size() * (c + 1) / chunks, queued[c]); });
+            pool.wait();
+        }
+
+        for (std::vector<Entry>& out : queued) {
+            for (const auto& [next_estimate, bits] : out)
+                buckets[next_estimate].push_back(bits);
+            out.clear();
+        }
+    }
+
+    return -1;
+}
+
+}
@@ -17,6 +17,12 @@
 #include <queue>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day24_part1 {
+
 struct Registers {
     __int128_t w {0};
     __int128_t x {0};
@@ -58,12 +64,20 @@ struct Instruction {
         return registers;
     }
 
-    friend std::istream& operator>>(std::istream& in, Instruction& instruction) {
-        in >> instruction.op >> instruction.arg1;
+    /* The tokens are at most 3 characters, so the strings never allocate. */
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, Instruction& instruction) {
+        std::string_view op {};
+        std::string_view arg1 {};
+        in >> op >> arg1;
+        instruction.op = op;
+        instruction.arg1 = arg1;
         if (instruction.op == "inp")
             return in;
-        else
-            return in >> instruction.arg2;
+
+        std::string_view arg2 {};
+        in >> arg2;
+        instruction.arg2 = arg2;
+        return in;
     }
 
     friend bool operator==(const Instruction& lhs, const Instruction& rhs) {
@@ -98,7 +112,7 @@ struct Segment {
         return registers;
     }
 
-    friend std::istream& operator>>(std::istream& in, Segment& segment) {
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, Segment& segment) {
         /* Each segment has 18 instructions. */
         for (int i {0}; i < 18; i++) {
             segment.instructions.push_back({});
@@ -126,7 +140,7 @@ struct SegmentedProgram {
         }
     }
 
-    friend std::istream& operator>>(std::istream& in, SegmentedProgram& program) {
+    friend aoc::Cursor& operator>>(aoc::Cursor& in, SegmentedProgram& program) {
         /* Each program has 14 segments. */
         for (int i {0}; i < 14; i++) {
             in >> program.segments[i];
@@ -149,12 +163,13 @@ __int128_t run_segment(const Segment& segment, int input, __int128_t z) {
  * That input could be found by performing program[3] on the input for one of
  * the digits, and looking up memo_map_steps[4][next_z]. Of course, generating
  * all such numbers this way is expensive. Instead, we intend to compute some
- * agregate info, like greatest valid number (part 1). */
-std::array<std::map<__int128_t, std::set<int>>, 14> memo_map_steps {};
+ * agregate info, like greatest valid number (part 1). Each solve() has its own,
+ * since they only hold for one program. */
+using MemoMapSteps = std::array<std::map<__int128_t, std::set<int>>, 14>;
 
 /* Returns whether this z value, at this step, succeeds for some input (which is
  * placed in memo_map_steps)*/
-bool has_valid_tail_from(const SegmentedProgram& program, const int step = 0, const __int128_t z = 0) {
+bool has_valid_tail_from(const SegmentedProgram& program, MemoMapSteps& memo_map_steps, const int step = 0, const __int128_t z = 0) {
     /* If we have reached the end of the program: */
     if (step == 14)
         return z == 0; // Return whether the input was valid.
@@ -168,9 +183,10 @@ bool has_valid_tail_from(const SegmentedProgram& program, const int step = 0, co
         return memo_map_steps[step][z].size() > 0; // Return whether there is a valid possible input tail.
 
     /* Perform the computation, and build memo map. */
+    AOC_TRACE_ADD("states_expanded", 1);
     memo_map_steps[step].insert({z, {}});
     for (int i {1}; i <= 9; i++)
-        if (has_valid_tail_from(program, step + 1, run_segment(program.segments[step], i, z)))
+        if (has_valid_tail_from(program, memo_map_steps, step + 1, run_segment(program.segments[step], i, z)))
             memo_map_steps[step][z].insert(i);
 
     return memo_map_steps[step][z].size() > 0;    
@@ -178,7 +194,7 @@ bool has_valid_tail_from(const SegmentedProgram& program, const int step = 0, co
 
 
 
-long find_largest_from_step(const SegmentedProgram& program, const int step = 0, const __int128_t z = 0) {
+long find_largest_from_step(const SegmentedProgram& program, MemoMapSteps& memo_map_steps, const int step = 0, const __int128_t z = 0) {
     /* Last step */
     if (step == 13) {
         return *memo_map_steps[13][z].rbegin();
@@ -189,17 +205,25 @@ long find_largest_from_step(const SegmentedProgram& program, const int step = 0,
     for (int i {step}; i < 13; i++)
         moved_digit *= 10;
     
-    return moved_digit + find_largest_from_step(program, step + 1, run_segment(program.segments[step], this_digit, z));
+    return moved_digit + find_largest_from_step(program, memo_map_steps, step + 1, run_segment(program.segments[step], this_digit, z));
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     SegmentedProgram prog {};
-    std::cin >> prog;
+    in >> prog;
+    AOC_TRACE_NEXT_PHASE("build");
     prog.prepare_z_bounds();
 
-    has_valid_tail_from(prog, 0, 0);
+    MemoMapSteps memo_map_steps {};
+    has_valid_tail_from(prog, memo_map_steps, 0, 0);
+
+    AOC_TRACE_NEXT_PHASE("solve");
+    return std::to_string(find_largest_from_step(prog, memo_map_steps));
+}
 
-    std::cout << find_largest_from_step(prog) << '\n';
+AOC_REGISTER_SOLVER(24, 1, "reference", solve);
 
-    return 0;
-}
\ No newline at end of file
+}
@@ -2,12 +2,18 @@
 #include <iostream>
 #include <vector>
 
+#include "../common/input.hpp"
+#include "../common/trace.hpp"
+#include "../common/solver.hpp"
+
+namespace day25_part1 {
+
 using Grid = std::vector<std::vector<char>>;
 
-std::istream& operator>>(std::istream& in, Grid& grid) {
+aoc::Cursor& operator>>(aoc::Cursor& in, Grid& grid) {
     grid = {};
 
-    std::string buffer {};
+    std::string_view buffer {};
     while (in >> buffer) {
         grid.push_back({});
         for (char ch : buffer) 
@@ -99,9 +105,16 @@ int first_still_round(Grid& grid) {
     return round;
 }
 
-int main() {
+std::string solve(std::string_view input) {
+    AOC_TRACE_PHASES("parse");
+    aoc::Cursor in {input};
+
     Grid grid {};
-    std::cin >> grid;
-    std::cout << first_still_round(grid) << '\n';
-    return 0;
-}
\ No newline at end of file
+    in >> grid;
+    AOC_TRACE_NEXT_PHASE("solve");
+    return std::to_string(first_still_round(grid));
+}
+
+AOC_REGISTER_SOLVER(25, 1, "reference", solve);
+
+}
@@ -0,0 +1,95 @@
+
+/* Replacements for the global allocation functions, counting every call into
+ * aoc::alloc::totals(). Only linked into AOC_ALLOC_COUNT builds; see
+ * common/alloc_count.hpp. */
+
+#include <cstdlib>
+#include <new>
+
+#include <malloc.h>
+
+#include "alloc_count.hpp"
+
+namespace aoc::alloc {
+
+/* A plain global rather than a function-local static: allocations can come
+ * from other static constructors, and constant initialization means this is
+ * ready before any of them run. */
+constinit Totals global_totals {};
+
+Totals& totals() {
+    return global_totals;
+}
+
+}
+
+namespace {
+
+void note_allocation(void* ptr, std::size_t size) {
+    aoc::alloc::Totals& t {aoc::alloc::global_totals};
+    long usable {static_cast<long>(malloc_usable_size(ptr))};
+
+    t.count.fetch_add(1, std::memory_order_relaxed);
+    t.bytes.fetch_add(static_cast<long>(size), std::memory_order_relaxed);
+    long live {t.live.fetch_add(usable, std::memory_order_relaxed) + usable};
+
+    long peak {t.peak.load(std::memory_order_relaxed)};
+    while (peak < live && !t.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+void* allocate(std::size_t size, std::size_t alignment) {
+    if (size == 0)
+        size = 1;
+
+    void* ptr {alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__
+        ? std::malloc(size)
+        : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)};
+    if (ptr != nullptr)
+        note_allocation(ptr, size);
+    return ptr;
+}
+
+void* allocate_or_throw(std::size_t size, std::size_t alignment) {
+    void* ptr {allocate(size, alignment)};
+    if (ptr == nullptr)
+        throw std::bad_alloc {};
+    return ptr;
+}
+
+void deallocate(void* ptr) {
+    if (ptr == nullptr)
+        return;
+    aoc::alloc::global_totals.live.fetch_sub(static_cast<long>(malloc_usable_size(ptr)), std::memory_order_relaxed);
+    std::free(ptr);
+}
+
+constexpr std::size_t default_alignment {__STDCPP_DEFAULT_NEW_ALIGNMENT__};
+
+}
+
+void* operator new(std::size_t size) { return allocate_or_throw(size, default_alignment); }
+void* operator new[](std::size_t size) { return allocate_or_throw(size, default_alignment); }
+void* operator new(std::size_t size, std::align_val_t align) { return allocate_or_throw(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return allocate_or_throw(size, static_cast<std::size_t>(align)); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, default_alignment); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, default_alignment); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<std::size_t>(align));
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(ptr); }
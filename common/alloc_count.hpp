@@ -0,0 +1,62 @@
+#pragma once
+
+/* Heap allocation accounting, for builds configured with AOC_ALLOC_COUNT.
+ *
+ * That build links common/alloc_count.cpp into every solver, which replaces
+ * the global operator new and delete with versions that keep running totals.
+ * Phases and scopes in common/trace.hpp then report how many allocations
+ * they made, how many bytes those asked for, and the most memory that was
+ * live on the heap at any point while they ran.
+ *
+ * Live memory is measured in malloc_usable_size() terms, which is what each
+ * block really costs; requested bytes are what the program asked for. Memory
+ * from malloc() directly (rare in C++ code) is not seen. */
+
+#include <atomic>
+
+namespace aoc::alloc {
+
+struct Totals {
+    std::atomic<long> count {0};
+    std::atomic<long> bytes {0};
+    std::atomic<long> live {0};
+    std::atomic<long> peak {0};
+};
+
+Totals& totals();
+
+/* What one phase or scope allocated. */
+struct Delta {
+    long count {};
+    long bytes {};
+    long peak_live {};
+};
+
+/* Brackets one phase or scope. The global peak is reset to the current live
+ * size on entry, so finish() can see the peak reached inside; it is then put
+ * back to the larger of the two, so enclosing windows still see it. */
+class Window {
+private:
+    long start_count;
+    long start_bytes;
+    long outer_peak;
+
+public:
+    Window()
+        : start_count {totals().count.load(std::memory_order_relaxed)},
+          start_bytes {totals().bytes.load(std::memory_order_relaxed)},
+          outer_peak {totals().peak.exchange(totals().live.load(std::memory_order_relaxed), std::memory_order_relaxed)} {}
+
+    Delta finish() {
+        Totals& t {totals()};
+        long inner_peak {t.peak.load(std::memory_order_relaxed)};
+        long peak {inner_peak};
+        while (peak < outer_peak && !t.peak.compare_exchange_weak(peak, outer_peak, std::memory_order_relaxed)) {}
+
+        return {t.count.load(std::memory_order_relaxed) - start_count,
+                t.bytes.load(std::memory_order_relaxed) - start_bytes,
+                inner_peak};
+    }
+};
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+/* Small helpers shared by the command line tools. Options are always spelled
+ * --name=value (or a bare --flag), which keeps the parsing trivial. */
+
+#include <charconv>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace aoc {
+
+/* If arg looks like --name=value, returns value. */
+inline std::optional<std::string_view> option_value(std::string_view arg, std::string_view name) {
+    if (arg.size() < name.size() + 3 || !arg.starts_with("--"))
+        return std::nullopt;
+    arg.remove_prefix(2);
+    if (!arg.starts_with(name) || arg[name.size()] != '=')
+        return std::nullopt;
+    return arg.substr(name.size() + 1);
+}
+
+inline long parse_long(std::string_view str) {
+    long num {};
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), num);
+    if (ec != std::errc {} || ptr != str.data() + str.size())
+        throw std::invalid_argument("expected a number, got '" + std::string {str} + "'");
+    return num;
+}
+
+inline double parse_double(std::string_view str) {
+    try {
+        size_t used {};
+        double num {std::stod(std::string {str}, &used)};
+        if (used == str.size())
+            return num;
+    }
+    catch (const std::logic_error&) {}
+    throw std::invalid_argument("expected a number, got '" + std::string {str} + "'");
+}
+
+/* Parses lists like "1-5,9,12-13" into the set of numbers they cover. */
+inline std::set<int> parse_number_set(std::string_view list) {
+    std::set<int> numbers {};
+
+    while (!list.empty()) {
+        size_t comma {list.find(',')};
+        std::string_view item {list.substr(0, comma)};
+        list = (comma == std::string_view::npos) ? std::string_view {} : list.substr(comma + 1);
+
+        size_t dash {item.find('-')};
+        if (dash == std::string_view::npos) {
+            numbers.insert(static_cast<int>(parse_long(item)));
+            continue;
+        }
+
+        int low {static_cast<int>(parse_long(item.substr(0, dash)))};
+        int high {static_cast<int>(parse_long(item.substr(dash + 1)))};
+        for (int i {low}; i <= high; i++)
+            numbers.insert(i);
+    }
+
+    return numbers;
+}
+
+/* "Day05-2" style names, matching the folder layout of the repository. */
+inline std::string day_name(int day, int part) {
+    std::string name {"Day"};
+    if (day < 10)
+        name += '0';
+    return name + std::to_string(day) + '-' + std::to_string(part);
+}
+
+}
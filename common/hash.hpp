@@ -0,0 +1,20 @@
+#pragma once
+
+/* The hash behind the open-addressed tables. Every bit of the key reaches
+ * every bit of the result, so a table can take its slot from the low bits
+ * whichever bits of its keys actually vary. (The MurmurHash3 finalizer.) */
+
+#include <cstdint>
+
+namespace aoc {
+
+inline std::uint64_t mix_hash(std::uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccd;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53;
+    key ^= key >> 33;
+    return key;
+}
+
+}
@@ -0,0 +1,302 @@
+#pragma once
+
+/* Zero-copy input handling shared by all of the solvers.
+ *
+ * InputFile maps the whole input into memory (falling back to reading it into
+ * a buffer when stdin is a pipe), and everything else works on string_views
+ * into that memory: Cursor is a small replacement for the std::istream
+ * extractors the solutions used to rely on, and lines() splits the input into
+ * lines without copying them.
+ *
+ * Cursor deliberately behaves like an istream: extractions skip leading
+ * whitespace, and once one fails the cursor converts to false and every later
+ * extraction is a no-op. That way `while (in >> thing)` loops keep working. */
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace aoc {
+
+class InputFile {
+private:
+    const char* data {nullptr};
+    size_t size {0};
+    bool mapped {false};
+    std::string buffer {}; // Only used when the input cannot be mapped.
+
+    InputFile() = default;
+
+public:
+    InputFile(const InputFile&) = delete;
+    InputFile& operator=(const InputFile&) = delete;
+
+    InputFile(InputFile&& moved) noexcept :
+        data {std::exchange(moved.data, nullptr)},
+        size {std::exchange(moved.size, 0)},
+        mapped {std::exchange(moved.mapped, false)},
+        buffer {std::move(moved.buffer)} {
+        if (!mapped)
+            data = buffer.data();
+    }
+
+    ~InputFile() {
+        if (mapped)
+            munmap(const_cast<char*>(data), size);
+    }
+
+    /* Maps fd if it refers to a regular file, otherwise reads it to the end.
+     * Does not take ownership of fd. */
+    static InputFile from_fd(int fd) {
+        InputFile file {};
+
+        struct stat info {};
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            void* addr {mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0)};
+            if (addr != MAP_FAILED) {
+                madvise(addr, info.st_size, MADV_SEQUENTIAL);
+                file.data = static_cast<const char*>(addr);
+                file.size = info.st_size;
+                file.mapped = true;
+                return file;
+            }
+        }
+
+        char chunk[1 << 16];
+        while (true) {
+            ssize_t count {read(fd, chunk, sizeof(chunk))};
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count < 0)
+                throw std::system_error(errno, std::generic_category(), "reading input");
+            if (count == 0)
+                break;
+            file.buffer.append(chunk, count);
+        }
+        file.data = file.buffer.data();
+        file.size = file.buffer.size();
+
+        return file;
+    }
+
+    static InputFile open(const std::string& path) {
+        int fd {::open(path.c_str(), O_RDONLY)};
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "opening " + path);
+
+        InputFile file {from_fd(fd)};
+        ::close(fd); // A mapping stays valid after its descriptor is closed.
+        return file;
+    }
+
+    /* The file named by argv[1] if there is one, otherwise stdin. */
+    static InputFile from_args(int argc, char* argv[]) {
+        if (argc >= 2)
+            return open(argv[1]);
+        return from_fd(STDIN_FILENO);
+    }
+
+    std::string_view text() const { return {data, size}; }
+};
+
+inline bool is_space(char ch) {
+    return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t' || ch == '\v' || ch == '\f';
+}
+
+class Cursor {
+private:
+    std::string_view text {};
+    size_t pos {0};
+    bool failed {false};
+
+public:
+    Cursor(std::string_view text) : text {text} {}
+
+    explicit operator bool() const { return !failed; }
+    bool fail() const { return failed; }
+
+    /* True once nothing but whitespace remains. */
+    bool at_end() {
+        skip_whitespace();
+        return pos >= text.size();
+    }
+
+    void set_fail() { failed = true; }
+
+    void skip_whitespace() {
+        while (pos < text.size() && is_space(text[pos]))
+            pos++;
+    }
+
+    /* Everything not consumed yet. */
+    std::string_view rest() const { return text.substr(pos); }
+
+    char peek() {
+        skip_whitespace();
+        return pos < text.size() ? text[pos] : '\0';
+    }
+
+    /* Next non-whitespace character. */
+    Cursor& operator>>(char& ch) {
+        skip_whitespace();
+        if (failed || pos >= text.size()) {
+            failed = true;
+            return *this;
+        }
+        ch = text[pos++];
+        return *this;
+    }
+
+    /* Next whitespace delimited token. */
+    Cursor& operator>>(std::string_view& token) {
+        skip_whitespace();
+        if (failed || pos >= text.size()) {
+            failed = true;
+            return *this;
+        }
+        size_t start {pos};
+        while (pos < text.size() && !is_space(text[pos]))
+            pos++;
+        token = text.substr(start, pos - start);
+        return *this;
+    }
+
+    template<typename T> requires std::integral<T> && (!std::same_as<T, char>) && (!std::same_as<T, bool>)
+    Cursor& operator>>(T& num) {
+        skip_whitespace();
+        if (failed || pos >= text.size()) {
+            failed = true;
+            return *this;
+        }
+        auto [ptr, ec] = std::from_chars(text.data() + pos, text.data() + text.size(), num);
+        if (ec != std::errc {}) {
+            failed = true;
+            return *this;
+        }
+        pos = ptr - text.data();
+        return *this;
+    }
+
+    /* Skips whitespace, then requires the next characters to be literal. */
+    Cursor& expect(std::string_view literal) {
+        skip_whitespace();
+        if (failed || text.substr(pos, literal.size()) != literal) {
+            failed = true;
+            return *this;
+        }
+        pos += literal.size();
+        return *this;
+    }
+
+    /* Skips the next n characters verbatim (no whitespace skipping). */
+    Cursor& skip(size_t n) {
+        if (failed || pos + n > text.size()) {
+            failed = true;
+            return *this;
+        }
+        pos += n;
+        return *this;
+    }
+
+    /* Like std::getline: the rest of the current line, without the line
+     * break. Fails only when there is nothing left at all. */
+    Cursor& getline(std::string_view& line) {
+        if (failed || pos >= text.size()) {
+            failed = true;
+            return *this;
+        }
+        size_t end {text.find('\n', pos)};
+        if (end == std::string_view::npos)
+            end = text.size();
+        line = text.substr(pos, end - pos);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        pos = std::min(end + 1, text.size());
+        return *this;
+    }
+};
+
+/* Forward range over the lines of a text, without their line breaks. A final
+ * line break does not produce an extra empty line. */
+class Lines {
+private:
+    std::string_view text {};
+
+public:
+    class Iterator {
+    private:
+        std::string_view rest {};
+        std::string_view line {};
+        bool done {false};
+
+        void advance() {
+            if (rest.empty()) {
+                done = true;
+                return;
+            }
+            size_t end {rest.find('\n')};
+            line = rest.substr(0, end);
+            rest = (end == std::string_view::npos) ? std::string_view {} : rest.substr(end + 1);
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+        }
+
+    public:
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() : done {true} {}
+        Iterator(std::string_view text) : rest {text} { advance(); }
+
+        std::string_view operator*() const { return line; }
+
+        Iterator& operator++() {
+            advance();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator temp {*this};
+            ++*this;
+            return temp;
+        }
+
+        bool operator==(const Iterator& other) const {
+            if (done || other.done)
+                return done == other.done;
+            return rest.data() == other.rest.data() && line.data() == other.line.data();
+        }
+    };
+
+    Lines(std::string_view text) : text {text} {}
+
+    Iterator begin() const { return Iterator(text); }
+    Iterator end() const { return Iterator(); }
+};
+
+inline Lines lines(std::string_view text) {
+    return Lines(text);
+}
+
+/* from_chars for a whole string_view; returns fallback if it is not a number. */
+template<typename T> requires std::integral<T>
+T to_int(std::string_view str, T fallback = 0) {
+    T num {};
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), num);
+    if (ec != std::errc {})
+        return fallback;
+    return num;
+}
+
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+/* A tiny streaming JSON writer. The tools only ever emit small, flat-ish
+ * documents (benchmark results, traces), so this keeps track of just enough
+ * state to place commas correctly. Nesting is the caller's responsibility.
+ *
+ * There is also a small reader, for tools that read those documents back. */
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace aoc {
+
+class JsonWriter {
+private:
+    std::ostream& out;
+    std::vector<bool> needs_comma {}; // One entry per open object / array.
+    bool after_key {false};
+    bool pending_newline {false}; // Deferred so commas stay at the end of lines.
+
+    void flush_newline() {
+        if (pending_newline)
+            out << '\n';
+        pending_newline = false;
+    }
+
+    void before_value() {
+        if (after_key) {
+            after_key = false;
+            return;
+        }
+        if (!needs_comma.empty()) {
+            if (needs_comma.back())
+                out << ',';
+            needs_comma.back() = true;
+        }
+        flush_newline();
+    }
+
+public:
+    JsonWriter(std::ostream& out) : out {out} {}
+
+    static std::string escape(std::string_view str) {
+        std::string escaped {};
+        for (char ch : str) {
+            switch (ch) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    char buf[8] {};
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", ch);
+                    escaped += buf;
+                }
+                else
+                    escaped += ch;
+            }
+        }
+        return escaped;
+    }
+
+    JsonWriter& begin_object() {
+        before_value();
+        out << '{';
+        needs_comma.push_back(false);
+        return *this;
+    }
+
+    JsonWriter& end_object() {
+        flush_newline();
+        needs_comma.pop_back();
+        out << '}';
+        return *this;
+    }
+
+    JsonWriter& begin_array() {
+        before_value();
+        out << '[';
+        needs_comma.push_back(false);
+        return *this;
+    }
+
+    JsonWriter& end_array() {
+        flush_newline();
+        needs_comma.pop_back();
+        out << ']';
+        return *this;
+    }
+
+    JsonWriter& key(std::string_view name) {
+        before_value();
+        out << '"' << escape(name) << "\":";
+        after_key = true;
+        return *this;
+    }
+
+    JsonWriter& value(std::string_view str) {
+        before_value();
+        out << '"' << escape(str) << '"';
+        return *this;
+    }
+
+    JsonWriter& value(const char* str) { return value(std::string_view {str}); }
+    JsonWriter& value(const std::string& str) { return value(std::string_view {str}); }
+
+    JsonWriter& value(bool b) {
+        before_value();
+        out << (b ? "true" : "false");
+        return *this;
+    }
+
+    /* Shortest representation that reads back as the same double. */
+    JsonWriter& value(double num) {
+        before_value();
+        char buf[32] {};
+        auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), num);
+        out << std::string_view {buf, static_cast<size_t>(end - buf)};
+        return *this;
+    }
+
+    template<typename T> requires std::is_integral_v<T>
+    JsonWriter& value(T num) {
+        before_value();
+        out << num;
+        return *this;
+    }
+
+    /* Requests a line break before whatever comes next; purely cosmetic. */
+    JsonWriter& newline() {
+        pending_newline = true;
+        return *this;
+    }
+
+    ~JsonWriter() {
+        flush_newline();
+    }
+
+    template<typename T>
+    JsonWriter& field(std::string_view name, const T& val) {
+        return key(name).value(val);
+    }
+};
+
+/* A parsed JSON value. Arrays keep their elements in items; objects keep
+ * their values in items and the matching names in keys, in document order. */
+struct JsonValue {
+    enum class Type {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object,
+    };
+
+    Type type {Type::Null};
+    bool boolean {false};
+    double number {0};
+    std::string string {};
+    std::vector<std::string> keys {};
+    std::vector<JsonValue> items {};
+
+    /* The member called name, or nullptr if there is none (or this is not an
+     * object). */
+    const JsonValue* find(std::string_view name) const {
+        for (size_t i {0}; i < keys.size(); i++)
+            if (keys[i] == name)
+                return &items[i];
+        return nullptr;
+    }
+};
+
+class JsonReader {
+private:
+    std::string_view text;
+    size_t pos {0};
+
+    [[noreturn]] void fail(std::string_view what) const {
+        throw std::invalid_argument("JSON: " + std::string {what} + " at offset " + std::to_string(pos));
+    }
+
+    void skip_space() {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\n' || text[pos] == '\r' || text[pos] == '\t'))
+            pos++;
+    }
+
+    void expect(char ch) {
+        skip_space();
+        if (pos >= text.size() || text[pos] != ch)
+            fail(std::string {"expected '"} + ch + "'");
+        pos++;
+    }
+
+    bool consume(std::string_view word) {
+        if (text.substr(pos, word.size()) != word)
+            return false;
+        pos += word.size();
+        return true;
+    }
+
+    /* Escapes for characters outside ASCII are not needed by anything we read. */
+    std::string read_string() {
+        expect('"');
+        std::string str {};
+        while (pos < text.size() && text[pos] != '"') {
+            char ch {text[pos++]};
+            if (ch != '\\') {
+                str += ch;
+                continue;
+            }
+            if (pos >= text.size())
+                break;
+            switch (char escaped {text[pos++]}) {
+            case 'n': str += '\n'; break;
+            case 'r': str += '\r'; break;
+            case 't': str += '\t'; break;
+            case 'b': str += '\b'; break;
+            case 'f': str += '\f'; break;
+            case 'u': {
+                unsigned code {};
+                auto [end, ec] = std::from_chars(text.data() + pos, text.data() + std::min(pos + 4, text.size()), code, 16);
+                if (ec != std::errc {} || end != text.data() + pos + 4 || code > 0x7f)
+                    fail("unsupported \\u escape");
+                str += static_cast<char>(code);
+                pos += 4;
+                break;
+            }
+            default: str += escaped;
+            }
+        }
+        expect('"');
+        return str;
+    }
+
+    JsonValue read_value() {
+        skip_space();
+        if (pos >= text.size())
+            fail("unexpected end");
+
+        JsonValue value {};
+        char ch {text[pos]};
+
+        if (ch == '{') {
+            value.type = JsonValue::Type::Object;
+            pos++;
+            skip_space();
+            if (consume("}"))
+                return value;
+            do {
+                value.keys.push_back(read_string());
+                expect(':');
+                value.items.push_back(read_value());
+                skip_space();
+            } while (consume(","));
+            expect('}');
+        }
+        else if (ch == '[') {
+            value.type = JsonValue::Type::Array;
+            pos++;
+            skip_space();
+            if (consume("]"))
+                return value;
+            do {
+                value.items.push_back(read_value());
+                skip_space();
+            } while (consume(","));
+            expect(']');
+        }
+        else if (ch == '"') {
+            value.type = JsonValue::Type::String;
+            value.string = read_string();
+        }
+        else if (consume("true")) {
+            value.type = JsonValue::Type::Bool;
+            value.boolean = true;
+        }
+        else if (consume("false")) {
+            value.type = JsonValue::Type::Bool;
+        }
+        else if (consume("null")) {
+            value.type = JsonValue::Type::Null;
+        }
+        else {
+            value.type = JsonValue::Type::Number;
+            auto [end, ec] = std::from_chars(text.data() + pos, text.data() + text.size(), value.number);
+            if (ec != std::errc {})
+                fail("expected a value");
+            pos = end - text.data();
+        }
+
+        return value;
+    }
+
+public:
+    JsonReader(std::string_view text) : text {text} {}
+
+    /* Throws std::invalid_argument on malformed input. */
+    JsonValue parse() {
+        JsonValue value {read_value()};
+        skip_space();
+        if (pos != text.size())
+            fail("trailing characters");
+        return value;
+    }
+};
+
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+/* Hardware performance counters through Linux's perf_event_open.
+ *
+ * Counters are opened one by one rather than as a group, so a machine that
+ * lacks one of them (VMs rarely expose LLC events, for instance) still reports
+ * the rest. Kernel and hypervisor time are excluded, which is what lets this
+ * work at the default perf_event_paranoid level of 2. Containers and most
+ * VMs refuse hardware counters entirely; then nothing opens, available() is
+ * false and error() says why. */
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace aoc::perf {
+
+enum Event {
+    Cycles,
+    Instructions,
+    L1d_Misses,
+    Llc_Misses,
+    Branch_Misses,
+};
+
+constexpr int event_count {5};
+
+constexpr std::array<const char*, event_count> event_names {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses",
+};
+
+/* One reading per event; -1 where the event could not be opened. */
+using Sample = std::array<long, event_count>;
+
+inline Sample difference(const Sample& end, const Sample& start) {
+    Sample delta {};
+    for (int i {0}; i < event_count; i++)
+        delta[i] = (end[i] < 0 || start[i] < 0) ? -1 : end[i] - start[i];
+    return delta;
+}
+
+class Counters {
+private:
+    std::array<int, event_count> fds {};
+    std::string reason {};
+
+    static perf_event_attr attributes(Event event) {
+        perf_event_attr attr {};
+        attr.size = sizeof(attr);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        switch (event) {
+        case Cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case Instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case L1d_Misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D
+                | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case Llc_Misses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES; // Last level, on every PMU that matters.
+            break;
+        case Branch_Misses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        }
+        return attr;
+    }
+
+    static std::string paranoid_level() {
+        std::ifstream in {"/proc/sys/kernel/perf_event_paranoid"};
+        std::string level {};
+        in >> level;
+        return level.empty() ? "unknown" : level;
+    }
+
+public:
+    /* Counts pid (0 for the calling thread). For a child that has not yet
+     * exec'd, on_exec starts counting at the exec and follows every thread
+     * and process it creates. */
+    explicit Counters(pid_t pid = 0, bool on_exec = false) {
+        fds.fill(-1);
+
+        int first_errno {0};
+        for (int i {0}; i < event_count; i++) {
+            perf_event_attr attr {attributes(static_cast<Event>(i))};
+            attr.disabled = on_exec ? 1 : 0;
+            attr.enable_on_exec = on_exec ? 1 : 0;
+            attr.inherit = on_exec ? 1 : 0;
+
+            fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, pid, -1, -1, PERF_FLAG_FD_CLOEXEC));
+            if (fds[i] < 0 && first_errno == 0)
+                first_errno = errno;
+        }
+
+        if (!available())
+            reason = std::string {"perf_event_open: "} + std::strerror(first_errno)
+                + " (kernel.perf_event_paranoid = " + paranoid_level() + ")";
+    }
+
+    Counters(const Counters&) = delete;
+    Counters& operator=(const Counters&) = delete;
+
+    ~Counters() {
+        for (int fd : fds)
+            if (fd >= 0)
+                close(fd);
+    }
+
+    /* Cycles and instructions are the minimum worth reporting. */
+    bool available() const {
+        return fds[Cycles] >= 0 && fds[Instructions] >= 0;
+    }
+
+    const std::string& error() const {
+        return reason;
+    }
+
+    /* Current totals, scaled up if the kernel had to multiplex counters. */
+    Sample read() const {
+        Sample sample {};
+        for (int i {0}; i < event_count; i++) {
+            uint64_t values[3] {}; // value, time enabled, time running
+            if (fds[i] < 0 || ::read(fds[i], values, sizeof(values)) != sizeof(values)) {
+                sample[i] = -1;
+                continue;
+            }
+            double scale {(values[2] == 0 || values[2] >= values[1]) ? 1.0 : static_cast<double>(values[1]) / values[2]};
+            sample[i] = static_cast<long>(values[0] * scale);
+        }
+        return sample;
+    }
+};
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+/* Timing a solver on one input file and reporting the result, shared by the
+ * per-day programs' batch mode and the aoc driver. */
+
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "input.hpp"
+#include "solver.hpp"
+
+namespace aoc {
+
+struct SolveResult {
+    bool ok {false};
+    std::string answer {}; // Or the error, if not ok.
+    double ms {};
+};
+
+inline double ms_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline SolveResult solve_text(const Solver& solver, std::string_view text) {
+    SolveResult result {};
+    auto start {std::chrono::steady_clock::now()};
+    try {
+        result.answer = solver.solve(text);
+        result.ok = true;
+    }
+    catch (const std::exception& e) {
+        result.answer = e.what();
+    }
+    result.ms = ms_since(start);
+    return result;
+}
+
+/* The time includes reading the input. */
+inline SolveResult solve_file(const Solver& solver, const std::string& path) {
+    auto start {std::chrono::steady_clock::now()};
+    SolveResult result {};
+    try {
+        InputFile input {InputFile::open(path)};
+        result = solve_text(solver, input.text());
+    }
+    catch (const std::exception& e) {
+        result.answer = e.what();
+    }
+    result.ms = ms_since(start);
+    return result;
+}
+
+/* One line per result: label, time, answer, then the note in brackets if
+ * there is one. Multi-line answers (Day 13's letters) start on a line of
+ * their own. */
+inline void print_result(std::ostream& out, std::string_view label, int label_width, const SolveResult& result,
+                         std::string_view note = "") {
+    out << std::left << std::setw(label_width) << label << std::right << std::fixed << std::setprecision(3)
+        << std::setw(12) << result.ms << " ms";
+
+    std::string bracketed {note.empty() ? "" : "  [" + std::string {note} + "]"};
+    if (!result.ok)
+        out << "  FAILED: " << result.answer << bracketed << '\n';
+    else if (result.answer.find('\n') != std::string::npos)
+        out << bracketed << '\n' << result.answer << '\n';
+    else
+        out << "  " << result.answer << bracketed << '\n';
+}
+
+}
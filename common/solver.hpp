@@ -0,0 +1,102 @@
+#pragma once
+
+/* The registry every solver adds itself to.
+ *
+ * A solver is a function from the puzzle input to its answer, as text:
+ *
+ *     namespace day05_part2 {
+ *     std::string solve(std::string_view input) { ... }
+ *     AOC_REGISTER_SOLVER(5, 2, "reference", solve);
+ *     }
+ *
+ * Each DayNN-P folder is compiled once and linked both into its own
+ * DayNN-P/solution program (common/solver_main.cpp) and into the aoc driver
+ * that runs many days at once (tools/driver). A day may register more than
+ * one engine; "reference" is the original solution, which the others are
+ * checked against.
+ *
+ * Solvers are registered with their version, which the build derives from
+ * their source (AOC_SOLVER_VERSION), so cached answers can be told apart from
+ * ones a different version of the code would give.
+ *
+ * Solvers must not write to stdout: the answer is what they return. They must
+ * also be re-entrant, keeping no mutable state outside solve() (memo tables
+ * and the like belong to one call), because both the driver and the batch
+ * mode of the per-day programs run them on several threads at once.
+ *
+ * A day can also register reports: functions of the same shape giving some
+ * other output than the answer, such as values along the way. They are kept
+ * apart from the engines, so the driver, its answer cache and aoc_difftest
+ * never take one for an answer; only the per-day programs run them, with
+ * --report=NAME. */
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc {
+
+using SolveFunction = std::string (*)(std::string_view input);
+
+struct Solver {
+    int day {};
+    int part {};
+    const char* engine {};
+    SolveFunction solve {};
+    const char* version {};
+};
+
+/* Sorted by day, part, then registration order. */
+inline std::vector<Solver>& solvers() {
+    static std::vector<Solver> registry {};
+    return registry;
+}
+
+inline bool register_solver(const Solver& solver) {
+    std::vector<Solver>& registry {solvers()};
+    auto after {std::upper_bound(registry.begin(), registry.end(), solver, [](const Solver& a, const Solver& b) {
+        return a.day != b.day ? a.day < b.day : a.part < b.part;
+    })};
+    registry.insert(after, solver);
+    return true;
+}
+
+/* The named engine for day and part, or nullptr. */
+inline const Solver* find_solver(int day, int part, std::string_view engine = "reference") {
+    for (const Solver& solver : solvers())
+        if (solver.day == day && solver.part == part && solver.engine == engine)
+            return &solver;
+    return nullptr;
+}
+
+/* The reports, in registration order; engine holds the report's name. */
+inline std::vector<Solver>& reports() {
+    static std::vector<Solver> registry {};
+    return registry;
+}
+
+inline bool register_report(const Solver& report) {
+    reports().push_back(report);
+    return true;
+}
+
+/* The named report for day and part, or nullptr. */
+inline const Solver* find_report(int day, int part, std::string_view name) {
+    for (const Solver& report : reports())
+        if (report.day == day && report.part == part && report.engine == name)
+            return &report;
+    return nullptr;
+}
+
+}
+
+#ifndef AOC_SOLVER_VERSION
+#define AOC_SOLVER_VERSION "unversioned"
+#endif
+
+#define AOC_REGISTER_SOLVER(day, part, engine, function) \
+    [[maybe_unused]] const bool registered_##function {aoc::register_solver({day, part, engine, function, AOC_SOLVER_VERSION})}
+
+#define AOC_REGISTER_REPORT(day, part, name, function) \
+    [[maybe_unused]] const bool registered_##function {aoc::register_report({day, part, name, function, AOC_SOLVER_VERSION})}
@@ -0,0 +1,173 @@
+
+/* main() for the DayNN-P/solution programs. Each is linked with exactly one
+ * day and part (see common/solver.hpp). Given one input file, or none to read
+ * stdin, it prints just the answer:
+ *
+ *     ./build/Day05-2/solution Day05-2/input.txt
+ *     ./build/Day05-2/solution --engine=reference < Day05-2/input.txt
+ *
+ * Given several files or a directory, it solves them all in this one process,
+ * several at a time, and prints each one's answer and time:
+ *
+ *     ./build/Day05-2/solution --jobs=8 inputs/day05/ extra.txt
+ *
+ * --report=NAME prints one of the day's reports instead of its answer (see
+ * common/solver.hpp):
+ *
+ *     ./build/Day22-2/solution --report=series Day22-2/input.txt */
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cli.hpp"
+#include "input.hpp"
+#include "run.hpp"
+#include "solver.hpp"
+#include "thread_pool.hpp"
+
+namespace fs = std::filesystem;
+
+void print_usage(const char* program) {
+    std::cerr << "usage: " << program << " [--engine=NAME | --report=NAME] [--jobs=N] [FILE | DIR]...\n"
+              << "engines:";
+    for (const aoc::Solver& solver : aoc::solvers())
+        std::cerr << ' ' << solver.engine;
+    std::cerr << '\n';
+    if (!aoc::reports().empty()) {
+        std::cerr << "reports:";
+        for (const aoc::Solver& report : aoc::reports())
+            std::cerr << ' ' << report.engine;
+        std::cerr << '\n';
+    }
+}
+
+/* Directories stand for the regular files directly inside them, in name
+ * order; hidden files are skipped. */
+std::vector<std::string> expand_paths(const std::vector<std::string>& paths) {
+    std::vector<std::string> files {};
+    for (const std::string& path : paths) {
+        if (!fs::is_directory(path)) {
+            files.push_back(path);
+            continue;
+        }
+
+        std::vector<std::string> inside {};
+        for (const fs::directory_entry& entry : fs::directory_iterator {path})
+            if (entry.is_regular_file() && !entry.path().filename().string().starts_with('.'))
+                inside.push_back(entry.path().string());
+        std::sort(inside.begin(), inside.end());
+        files.insert(files.end(), inside.begin(), inside.end());
+    }
+    return files;
+}
+
+int solve_batch(const aoc::Solver& solver, const std::vector<std::string>& files, unsigned jobs) {
+    std::vector<aoc::SolveResult> results(files.size());
+
+    auto start {std::chrono::steady_clock::now()};
+    {
+        aoc::ThreadPool pool {std::min<unsigned>(jobs, files.size())};
+        for (size_t i {0}; i < files.size(); i++)
+            pool.submit([&, i] { results[i] = aoc::solve_file(solver, files[i]); });
+        pool.wait();
+    }
+    auto end {std::chrono::steady_clock::now()};
+
+    int width {0};
+    for (const std::string& file : files)
+        width = std::max(width, static_cast<int>(file.size()));
+
+    int failures {0};
+    double total_ms {0};
+    for (size_t i {0}; i < files.size(); i++) {
+        aoc::print_result(std::cout, files[i], width, results[i]);
+        failures += !results[i].ok;
+        total_ms += results[i].ms;
+    }
+
+    double wall_ms {std::chrono::duration<double, std::milli>(end - start).count()};
+    std::cout << files.size() << " inputs in " << wall_ms << " ms on " << std::min<size_t>(jobs, files.size())
+              << " threads (" << total_ms << " ms if run one after another)";
+    if (failures > 0)
+        std::cout << ", " << failures << " failed";
+    std::cout << '\n';
+
+    return failures > 0 ? 1 : 0;
+}
+
+int main(int argc, char *argv[]) {
+    std::string engine {"reference"};
+    std::string report {};
+    unsigned jobs {aoc::ThreadPool::default_threads()};
+    std::vector<std::string> paths {};
+
+    try {
+        for (int i {1}; i < argc; i++) {
+            std::string_view arg {argv[i]};
+
+            if (auto v {aoc::option_value(arg, "engine")})
+                engine = *v;
+            else if (auto v {aoc::option_value(arg, "report")})
+                report = *v;
+            else if (auto v {aoc::option_value(arg, "jobs")})
+                jobs = static_cast<unsigned>(std::max(1L, aoc::parse_long(*v)));
+            else if (arg.starts_with("--")) {
+                print_usage(argv[0]);
+                return arg == "--help" ? 0 : 2;
+            }
+            else
+                paths.emplace_back(arg);
+        }
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << argv[0] << ": " << e.what() << '\n';
+        return 2;
+    }
+
+    if (aoc::solvers().empty()) {
+        std::cerr << argv[0] << ": no solver linked in\n";
+        return 2;
+    }
+
+    const aoc::Solver& any {aoc::solvers().front()};
+    const aoc::Solver* solver {nullptr};
+    if (!report.empty()) {
+        solver = aoc::find_report(any.day, any.part, report);
+        if (solver == nullptr) {
+            std::cerr << argv[0] << ": no report called '" << report << "'\n";
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    else
+        solver = aoc::find_solver(any.day, any.part, engine);
+    if (solver == nullptr) {
+        std::cerr << argv[0] << ": no engine called '" << engine << "'\n";
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    if (paths.size() > 1 || (paths.size() == 1 && fs::is_directory(paths[0]))) {
+        try {
+            return solve_batch(*solver, expand_paths(paths), jobs);
+        }
+        catch (const fs::filesystem_error& e) {
+            std::cerr << argv[0] << ": " << e.what() << '\n';
+            return 1;
+        }
+    }
+
+    try {
+        aoc::InputFile input {paths.empty() ? aoc::InputFile::from_fd(STDIN_FILENO) : aoc::InputFile::open(paths[0])};
+        std::cout << solver->solve(input.text()) << '\n';
+    }
+    catch (const std::exception& e) { // Unreadable input, or input the solver rejects.
+        std::cerr << argv[0] << ": " << e.what() << '\n';
+        return 1;
+    }
+}
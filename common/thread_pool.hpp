@@ -0,0 +1,89 @@
+#pragma once
+
+/* A fixed set of worker threads taking jobs off a queue in the order they
+ * were submitted. Jobs must handle their own exceptions. */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+class ThreadPool {
+private:
+    std::vector<std::thread> workers {};
+    std::deque<std::function<void()>> queue {};
+    std::mutex mutex {};
+    std::condition_variable work_available {};
+    std::condition_variable all_done {};
+    size_t running {0};
+    bool stopping {false};
+
+    void work() {
+        std::unique_lock lock {mutex};
+        while (true) {
+            work_available.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty())
+                return;
+
+            std::function<void()> job {std::move(queue.front())};
+            queue.pop_front();
+            running++;
+
+            lock.unlock();
+            job();
+            lock.lock();
+
+            running--;
+            if (queue.empty() && running == 0)
+                all_done.notify_all();
+        }
+    }
+
+public:
+    explicit ThreadPool(unsigned threads) {
+        for (unsigned i {0}; i < std::max(threads, 1u); i++)
+            workers.emplace_back([this] { work(); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /* Finishes everything already queued first. */
+    ~ThreadPool() {
+        {
+            std::lock_guard lock {mutex};
+            stopping = true;
+        }
+        work_available.notify_all();
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    /* One thread per core, or one if that cannot be found out. */
+    static unsigned default_threads() {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    void submit(std::function<void()> job) {
+        {
+            std::lock_guard lock {mutex};
+            queue.push_back(std::move(job));
+        }
+        work_available.notify_one();
+    }
+
+    /* Blocks until the queue is empty and no job is running. */
+    void wait() {
+        std::unique_lock lock {mutex};
+        all_done.wait(lock, [this] { return queue.empty() && running == 0; });
+    }
+};
+
+}
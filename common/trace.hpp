@@ -0,0 +1,358 @@
+#pragma once
+
+/* Phase timing for the solvers.
+ *
+ *     AOC_TRACE_PHASES("parse");       // Times consecutive phases of main().
+ *     AOC_TRACE_NEXT_PHASE("solve");
+ *     AOC_TRACE_SCOPE("construct_map"); // Times the enclosing block.
+ *     AOC_TRACE_COUNTER("memo_states", memo.size()); // Samples a value.
+ *     AOC_TRACE_ADD("states_expanded", 1); // Running total, cheap in hot loops.
+ *
+ * Names must be string literals. Unless the solvers are built with AOC_TRACE
+ * (cmake -DAOC_TRACE=ON, which defines AOC_ENABLE_TRACE) all of these expand
+ * to nothing, and their arguments are not evaluated.
+ *
+ * When enabled, a summary is printed to stderr at exit. If AOC_TRACE_FILE is
+ * set, every event is also written there in Chrome's trace event format, which
+ * chrome://tracing and https://ui.perfetto.dev can open.
+ *
+ * If AOC_PERF is set as well, each phase also reads the hardware counters in
+ * common/perf.hpp on entry and exit and records the difference in its event's
+ * args; aoc_bench --perf relies on this. Scopes are left alone, since the
+ * extra syscalls would distort the short ones.
+ *
+ * Builds configured with AOC_ALLOC_COUNT (which implies AOC_TRACE) also count
+ * heap allocations in every phase and scope; see common/alloc_count.hpp. */
+
+#ifdef AOC_ENABLE_TRACE
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "alloc_count.hpp"
+#include "json.hpp"
+#include "perf.hpp"
+
+namespace aoc::trace {
+
+struct Event {
+    const char* name {};
+    char kind {};       // 'X' for a timed scope, 'C' for a counter sample.
+    long start_ns {};
+    long duration_ns {};
+    int thread {};
+    long value {};
+    bool has_perf {false};
+    perf::Sample perf {}; // Counter deltas over a phase.
+    bool has_alloc {false};
+    alloc::Delta alloc {};
+};
+
+/* Counts allocations from its construction to finish(), in AOC_ALLOC_COUNT
+ * builds; otherwise it does nothing. */
+class AllocWindow {
+#ifdef AOC_ENABLE_ALLOC_COUNT
+private:
+    alloc::Window window {};
+
+public:
+    void finish(Event& event) {
+        event.has_alloc = true;
+        event.alloc = window.finish();
+    }
+#else
+public:
+    void finish(Event&) {}
+#endif
+};
+
+/* Running total for AOC_TRACE_ADD; one per call site. */
+struct Tally {
+    const char* name {};
+    std::atomic<long> total {0};
+};
+
+/* Small sequential ids, which read better in a viewer than pthread ids. */
+inline int thread_index() {
+    static std::atomic<int> next {0};
+    thread_local int index {next++};
+    return index;
+}
+
+class Recorder {
+private:
+    std::chrono::steady_clock::time_point start {std::chrono::steady_clock::now()};
+    std::mutex mutex {};
+    std::vector<Event> events {};
+    std::vector<std::unique_ptr<Tally>> tallies {};
+    std::unique_ptr<perf::Counters> counters {};
+    std::thread::id owner {std::this_thread::get_id()};
+
+    /* The solvers are all called "solution", so those are named after the
+     * folder they were built in (Day19-1 etc). */
+    static std::string process_name() {
+        std::error_code ec {};
+        std::filesystem::path exe {std::filesystem::read_symlink("/proc/self/exe", ec)};
+        if (ec)
+            return "unknown";
+        if (exe.filename() == "solution")
+            return exe.parent_path().filename().string();
+        return exe.filename().string();
+    }
+
+    void write_chrome_trace(const char* path) {
+        std::ofstream out {path};
+        JsonWriter json {out};
+        long pid {getpid()};
+
+        json.begin_object().key("traceEvents").begin_array().newline();
+
+        json.begin_object()
+            .field("name", "process_name").field("ph", "M").field("pid", pid)
+            .key("args").begin_object().field("name", process_name()).end_object()
+            .end_object().newline();
+
+        for (const Event& event : events) {
+            json.begin_object();
+            json.field("name", event.name);
+            json.field("ph", std::string_view {&event.kind, 1});
+            json.field("ts", event.start_ns / 1000.0);
+            if (event.kind == 'X')
+                json.field("dur", event.duration_ns / 1000.0);
+            json.field("pid", pid);
+            json.field("tid", event.thread);
+            if (event.kind == 'C')
+                json.key("args").begin_object().field("value", event.value).end_object();
+            if (event.has_perf || event.has_alloc) {
+                json.key("args").begin_object();
+                for (int i {0}; event.has_perf && i < perf::event_count; i++)
+                    if (event.perf[i] >= 0)
+                        json.field(perf::event_names[i], event.perf[i]);
+                if (event.has_alloc)
+                    json.field("allocations", event.alloc.count)
+                        .field("allocated_bytes", event.alloc.bytes)
+                        .field("peak_live_bytes", event.alloc.peak_live);
+                json.end_object();
+            }
+            json.end_object().newline();
+        }
+
+        json.end_array().newline();
+        json.end_object().newline();
+    }
+
+    void print_summary() {
+        struct Total {
+            const char* name {};
+            long calls {};
+            long ns {};
+            bool has_alloc {false};
+            alloc::Delta alloc {}; // Summed, except the peak, which is the largest.
+        };
+        std::vector<Total> totals {};
+
+        for (const Event& event : events) {
+            if (event.kind != 'X')
+                continue;
+            auto it {std::find_if(totals.begin(), totals.end(),
+                                  [&](const Total& t) { return std::string_view {t.name} == event.name; })};
+            if (it == totals.end())
+                it = totals.insert(totals.end(), Total {event.name, 0, 0});
+            it->calls++;
+            it->ns += event.duration_ns;
+            if (event.has_alloc) {
+                it->has_alloc = true;
+                it->alloc.count += event.alloc.count;
+                it->alloc.bytes += event.alloc.bytes;
+                it->alloc.peak_live = std::max(it->alloc.peak_live, event.alloc.peak_live);
+            }
+        }
+
+        std::ostream& out {std::cerr};
+        out << std::fixed << std::setprecision(3);
+        for (const Total& total : totals) {
+            out << "trace: " << std::left << std::setw(32) << total.name << std::right
+                << std::setw(12) << total.ns / 1e6 << " ms";
+            if (total.has_alloc)
+                out << std::setw(12) << total.alloc.count << " allocs"
+                    << std::setw(12) << total.alloc.bytes / 1048576.0 << " MB"
+                    << "  peak" << std::setw(10) << total.alloc.peak_live / 1048576.0 << " MB";
+            if (total.calls > 1)
+                out << "  (" << total.calls << " calls)";
+            out << '\n';
+        }
+
+        /* Counters show their last sample, tallies their total. */
+        std::vector<const Event*> last_samples {};
+        for (const Event& event : events) {
+            if (event.kind != 'C')
+                continue;
+            auto it {std::find_if(last_samples.begin(), last_samples.end(),
+                                  [&](const Event* e) { return std::string_view {e->name} == event.name; })};
+            if (it == last_samples.end())
+                last_samples.push_back(&event);
+            else
+                *it = &event;
+        }
+
+        for (const Event* event : last_samples)
+            out << "trace: " << std::left << std::setw(32) << event->name << std::right
+                << std::setw(12) << event->value << '\n';
+    }
+
+public:
+    /* Room for plenty of events up front, so recording them does not usually
+     * allocate and skew the allocation counts. */
+    Recorder() {
+        events.reserve(1024);
+
+        if (const char* enabled {std::getenv("AOC_PERF")}; enabled != nullptr && *enabled != '\0') {
+            counters = std::make_unique<perf::Counters>();
+            if (!counters->available()) {
+                std::cerr << "trace: no hardware counters, " << counters->error() << '\n';
+                counters.reset();
+            }
+        }
+    }
+
+    long now_ns() const {
+        auto elapsed {std::chrono::steady_clock::now() - start};
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
+    void record(const Event& event) {
+        std::lock_guard lock {mutex};
+        events.push_back(event);
+    }
+
+    /* Only the thread that created the recorder is counted, so phases on any
+     * other thread (batch mode, the driver) get no counters. */
+    std::optional<perf::Sample> read_counters() const {
+        if (counters == nullptr || std::this_thread::get_id() != owner)
+            return std::nullopt;
+        return counters->read();
+    }
+
+    Tally& tally(const char* name) {
+        std::lock_guard lock {mutex};
+        tallies.push_back(std::make_unique<Tally>());
+        tallies.back()->name = name;
+        return *tallies.back();
+    }
+
+    /* Tallies become counter samples at the very end, so they show up in
+     * the trace file as well. */
+    ~Recorder() {
+        long end {now_ns()};
+        for (const auto& tally : tallies)
+            events.push_back({tally->name, 'C', end, 0, 0, tally->total.load()});
+
+        print_summary();
+        if (const char* path {std::getenv("AOC_TRACE_FILE")}; path != nullptr && *path != '\0')
+            write_chrome_trace(path);
+    }
+};
+
+inline Recorder& recorder() {
+    static Recorder instance {};
+    return instance;
+}
+
+class Scope {
+private:
+    const char* name;
+    long start_ns;
+    AllocWindow allocations {};
+
+public:
+    explicit Scope(const char* name) : name {name}, start_ns {recorder().now_ns()} {}
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope() {
+        long end_ns {recorder().now_ns()};
+        Event event {name, 'X', start_ns, end_ns - start_ns, thread_index(), 0};
+        allocations.finish(event);
+        recorder().record(event);
+    }
+};
+
+/* A sequence of back to back scopes: starting one phase ends the last. */
+class Phases {
+private:
+    const char* name;
+    long start_ns;
+    std::optional<perf::Sample> start_counters;
+    AllocWindow allocations {};
+
+    void finish(long end_ns, const std::optional<perf::Sample>& end_counters) {
+        Event event {name, 'X', start_ns, end_ns - start_ns, thread_index(), 0};
+        if (start_counters && end_counters) {
+            event.has_perf = true;
+            event.perf = perf::difference(*end_counters, *start_counters);
+        }
+        allocations.finish(event);
+        recorder().record(event);
+    }
+
+public:
+    explicit Phases(const char* first)
+        : name {first}, start_ns {recorder().now_ns()}, start_counters {recorder().read_counters()} {}
+    Phases(const Phases&) = delete;
+    Phases& operator=(const Phases&) = delete;
+
+    ~Phases() { finish(recorder().now_ns(), recorder().read_counters()); }
+
+    void next(const char* next_name) {
+        std::optional<perf::Sample> counters {recorder().read_counters()};
+        long now {recorder().now_ns()};
+        finish(now, counters);
+        name = next_name;
+        start_ns = now;
+        start_counters = counters;
+        allocations = AllocWindow {};
+    }
+};
+
+inline void counter(const char* name, long value) {
+    recorder().record({name, 'C', recorder().now_ns(), 0, thread_index(), value});
+}
+
+}
+
+#define AOC_TRACE_CONCAT_INNER(a, b) a##b
+#define AOC_TRACE_CONCAT(a, b) AOC_TRACE_CONCAT_INNER(a, b)
+
+#define AOC_TRACE_SCOPE(name) aoc::trace::Scope AOC_TRACE_CONCAT(aoc_trace_scope_, __LINE__) {name}
+#define AOC_TRACE_PHASES(name) aoc::trace::Phases aoc_trace_phases {name}
+#define AOC_TRACE_NEXT_PHASE(name) aoc_trace_phases.next(name)
+#define AOC_TRACE_COUNTER(name, value) aoc::trace::counter(name, static_cast<long>(value))
+#define AOC_TRACE_ADD(name, amount) do { \
+        static aoc::trace::Tally& aoc_trace_tally {aoc::trace::recorder().tally(name)}; \
+        aoc_trace_tally.total.fetch_add(amount, std::memory_order_relaxed); \
+    } while (false)
+
+#else
+
+#define AOC_TRACE_SCOPE(name) static_cast<void>(0)
+#define AOC_TRACE_PHASES(name) static_cast<void>(0)
+#define AOC_TRACE_NEXT_PHASE(name) static_cast<void>(0)
+#define AOC_TRACE_COUNTER(name, value) static_cast<void>(sizeof(value))
+#define AOC_TRACE_ADD(name, amount) static_cast<void>(sizeof(amount))
+
+#endif
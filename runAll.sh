@@ -1,17 +1,15 @@
-#!/bin/zsh
+#!/bin/sh
 
-# Copied from ~/.custom_aliases
-alias G++CPPC='g++-11 -std=c++20 -Wall -Wextra -Werror -Wpedantic -nostdinc++ -nodefaultlibs -lc -isystem /usr/local/Cellar/llvm/14.0.6_1/include/c++/v1 -lc++ -lc++abi'
-alias CPPC='/usr/local/Cellar/llvm/15.0.1/bin/clang++ -std=c++20 -Wall -Wextra -Werror -Wpedantic'
+# Builds every day with CMake and benchmarks it against its input.txt.
+# Extra arguments are passed through to aoc_bench, e.g.
+#   ./runAll.sh --runs=20 --days=19-23
+# Results are also written to build/bench.json.
 
-for folder in Day*/;
-do
-    ( # These parentheses mean everything is run in a subshell, with its own current working directory.
-        cd $folder
-        echo "________${folder:0:-1}________"
-        echo "[Compiling Solution]"
-        CPPC -O3 solution.cpp -o solution
-        echo "[Running]"
-        time ./solution < input.txt
-    )
-done
+set -e
+
+cd "$(dirname "$0")"
+
+cmake -S . -B build -DCMAKE_BUILD_TYPE=Release
+cmake --build build -j"$(nproc)"
+
+./build/aoc_bench --json=build/bench.json "$@"
@@ -0,0 +1,550 @@
+
+/* aoc_bench: runs every built solver repeatedly against the same input and
+ * reports wall time statistics and peak memory.
+ *
+ * Each run is a fresh process (fork + exec), exactly like running the solver
+ * by hand, so process start-up is included in the numbers. A few warm-up runs
+ * are thrown away first so the binary and its input are in the page cache.
+ *
+ * With --perf, one more run per solver is made under hardware counters (see
+ * common/perf.hpp), after the timed ones so they are not disturbed by it. The
+ * whole process is always counted; solvers built with AOC_TRACE also report
+ * their phases, through the trace file they write. */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../../common/cli.hpp"
+#include "../../common/json.hpp"
+#include "../../common/perf.hpp"
+
+namespace fs = std::filesystem;
+
+struct Options {
+    fs::path source_dir {AOC_SOURCE_DIR};
+    fs::path bin_dir {AOC_BINARY_DIR};
+    std::string input_name {"input.txt"};
+    fs::path json_path {"bench.json"};
+    std::set<int> days {};
+    std::set<int> parts {1, 2};
+    int runs {10};
+    int warmup {2};
+    bool perf {false};
+};
+
+struct RunResult {
+    double wall_ms {};
+    long max_rss_kb {};
+    int exit_status {};
+};
+
+struct PhaseCounters {
+    std::string name {};
+    aoc::perf::Sample counts {};
+};
+
+struct CountedRun {
+    aoc::perf::Sample total {};
+    std::vector<PhaseCounters> phases {}; // Empty unless built with AOC_TRACE.
+};
+
+struct SolverStats {
+    std::string name {};
+    fs::path input {};
+    std::vector<double> wall_ms {};
+    long peak_rss_kb {0};
+    int failures {0};
+    std::string output {};
+    long elements {0};
+    std::string element_unit {};
+    std::optional<CountedRun> counted {};
+};
+
+/* Runs binary < input once. If capture is set, stdout is written there,
+ * otherwise it is discarded. */
+RunResult run_once(const fs::path& binary, const fs::path& input, const std::optional<fs::path>& capture) {
+    auto start {std::chrono::steady_clock::now()};
+
+    pid_t pid {fork()};
+    if (pid < 0) {
+        perror("fork");
+        std::exit(1);
+    }
+
+    if (pid == 0) {
+        int in_fd {open(input.c_str(), O_RDONLY)};
+        int out_fd {capture ? open(capture->c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) : open("/dev/null", O_WRONLY)};
+        int null_fd {open("/dev/null", O_WRONLY)};
+        if (in_fd < 0 || out_fd < 0 || null_fd < 0)
+            _exit(127);
+
+        dup2(in_fd, STDIN_FILENO);
+        dup2(out_fd, STDOUT_FILENO);
+        dup2(null_fd, STDERR_FILENO);
+
+        /* Solvers may look for sibling files, so run them next to their input. */
+        if (chdir(input.parent_path().c_str()) != 0)
+            _exit(127);
+
+        execl(binary.c_str(), binary.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    int status {};
+    rusage usage {};
+    wait4(pid, &status, 0, &usage);
+
+    auto end {std::chrono::steady_clock::now()};
+
+    RunResult result {};
+    result.wall_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    result.max_rss_kb = usage.ru_maxrss; // Kilobytes on Linux.
+    result.exit_status = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+
+    return result;
+}
+
+std::string read_file(const fs::path& path) {
+    std::ifstream in {path, std::ios::binary};
+    std::ostringstream contents {};
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+/* Runs binary < input once under hardware counters. The child waits on a
+ * pipe until the counters are attached, and they only start at its exec. */
+CountedRun run_counted(const fs::path& binary, const fs::path& input, const fs::path& trace) {
+    int ready[2] {};
+    if (pipe(ready) != 0) {
+        perror("pipe");
+        std::exit(1);
+    }
+
+    pid_t pid {fork()};
+    if (pid < 0) {
+        perror("fork");
+        std::exit(1);
+    }
+
+    if (pid == 0) {
+        close(ready[1]);
+        char go {};
+        if (read(ready[0], &go, 1) != 1)
+            _exit(127);
+        close(ready[0]);
+
+        int in_fd {open(input.c_str(), O_RDONLY)};
+        int null_fd {open("/dev/null", O_WRONLY)};
+        if (in_fd < 0 || null_fd < 0)
+            _exit(127);
+
+        dup2(in_fd, STDIN_FILENO);
+        dup2(null_fd, STDOUT_FILENO);
+        dup2(null_fd, STDERR_FILENO);
+
+        if (chdir(input.parent_path().c_str()) != 0)
+            _exit(127);
+
+        setenv("AOC_PERF", "1", 1);
+        setenv("AOC_TRACE_FILE", trace.c_str(), 1);
+        execl(binary.c_str(), binary.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    close(ready[0]);
+    aoc::perf::Counters counters {pid, true};
+    if (write(ready[1], "x", 1) != 1)
+        perror("write");
+    close(ready[1]);
+
+    int status {};
+    waitpid(pid, &status, 0);
+
+    CountedRun run {};
+    run.total = counters.read();
+
+    /* Phases are the timed scopes that carry counters. */
+    if (fs::exists(trace)) {
+        try {
+            std::string text {read_file(trace)};
+            aoc::JsonValue document {aoc::JsonReader {text}.parse()};
+            const aoc::JsonValue* events {document.find("traceEvents")};
+            for (size_t i {0}; events != nullptr && i < events->items.size(); i++) {
+                const aoc::JsonValue& event {events->items[i]};
+                const aoc::JsonValue* name {event.find("name")};
+                const aoc::JsonValue* phase {event.find("ph")};
+                const aoc::JsonValue* args {event.find("args")};
+                if (name == nullptr || phase == nullptr || phase->string != "X"
+                        || args == nullptr || args->find("cycles") == nullptr)
+                    continue;
+
+                PhaseCounters counts {name->string, {}};
+                for (int j {0}; j < aoc::perf::event_count; j++) {
+                    const aoc::JsonValue* count {args->find(aoc::perf::event_names[j])};
+                    counts.counts[j] = count != nullptr ? static_cast<long>(count->number) : -1;
+                }
+                run.phases.push_back(counts);
+            }
+        }
+        catch (const std::invalid_argument& e) {
+            std::cerr << "aoc_bench: ignoring unreadable trace " << trace.string() << ": " << e.what() << '\n';
+        }
+        fs::remove(trace);
+    }
+
+    return run;
+}
+
+/* Inputs are measured in lines, except on the days whose input is a grid (or
+ * one long hex string), where a line is far too coarse; those count cells. */
+std::pair<long, std::string> count_elements(const std::string& contents, int day) {
+    static const std::set<int> cell_days {9, 11, 15, 16, 20, 25};
+
+    long count {0};
+    if (cell_days.contains(day)) {
+        for (char ch : contents)
+            count += !std::isspace(static_cast<unsigned char>(ch));
+        return {count, "cells"};
+    }
+
+    bool in_line {false};
+    for (char ch : contents) {
+        if (ch == '\n') {
+            count += in_line;
+            in_line = false;
+        }
+        else
+            in_line = true;
+    }
+    return {count + in_line, "lines"};
+}
+
+/* Nearest-rank percentile of an already sorted vector. */
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty())
+        return 0;
+    int rank {static_cast<int>(std::ceil(p / 100.0 * sorted.size()))};
+    return sorted[std::clamp(rank - 1, 0, static_cast<int>(sorted.size()) - 1)];
+}
+
+double median(const std::vector<double>& sorted) {
+    if (sorted.empty())
+        return 0;
+    size_t n {sorted.size()};
+    if (n % 2 == 1)
+        return sorted[n / 2];
+    return (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+}
+
+std::string git_commit(const fs::path& source_dir) {
+    std::string command {"git -C '" + source_dir.string() + "' rev-parse HEAD 2>/dev/null"};
+    FILE* pipe {popen(command.c_str(), "r")};
+    if (pipe == nullptr)
+        return "unknown";
+
+    char buf[64] {};
+    std::string commit {};
+    while (fgets(buf, sizeof(buf), pipe) != nullptr)
+        commit += buf;
+    pclose(pipe);
+
+    while (!commit.empty() && std::isspace(static_cast<unsigned char>(commit.back())))
+        commit.pop_back();
+    return commit.empty() ? "unknown" : commit;
+}
+
+std::string iso_timestamp() {
+    std::time_t now {std::time(nullptr)};
+    char buf[32] {};
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return buf;
+}
+
+void print_usage() {
+    std::cerr << "usage: aoc_bench [--runs=N] [--warmup=N] [--days=1-25] [--parts=1,2]\n"
+                 "                 [--input=input.txt] [--json=bench.json] [--perf]\n"
+                 "                 [--source-dir=DIR] [--bin-dir=DIR]\n";
+}
+
+Options parse_options(int argc, char* argv[]) {
+    Options options {};
+    for (int i {1}; i <= 25; i++)
+        options.days.insert(i);
+
+    for (int i {1}; i < argc; i++) {
+        std::string_view arg {argv[i]};
+
+        if (auto v {aoc::option_value(arg, "runs")})
+            options.runs = std::max(1L, aoc::parse_long(*v));
+        else if (auto v {aoc::option_value(arg, "warmup")})
+            options.warmup = std::max(0L, aoc::parse_long(*v));
+        else if (auto v {aoc::option_value(arg, "days")})
+            options.days = aoc::parse_number_set(*v);
+        else if (auto v {aoc::option_value(arg, "parts")})
+            options.parts = aoc::parse_number_set(*v);
+        else if (auto v {aoc::option_value(arg, "input")})
+            options.input_name = *v;
+        else if (auto v {aoc::option_value(arg, "json")})
+            options.json_path = *v;
+        else if (auto v {aoc::option_value(arg, "source-dir")})
+            options.source_dir = *v;
+        else if (auto v {aoc::option_value(arg, "bin-dir")})
+            options.bin_dir = *v;
+        else if (arg == "--perf")
+            options.perf = true;
+        else {
+            print_usage();
+            std::exit(arg == "--help" ? 0 : 2);
+        }
+    }
+
+    return options;
+}
+
+/* Instructions per cycle, and each kind of miss per input element. */
+struct Rates {
+    double ipc {-1};
+    std::array<double, 3> misses_per_element {-1, -1, -1};
+};
+
+constexpr std::array<aoc::perf::Event, 3> miss_events {
+    aoc::perf::L1d_Misses, aoc::perf::Llc_Misses, aoc::perf::Branch_Misses,
+};
+
+Rates rates(const aoc::perf::Sample& counts, long elements) {
+    Rates rates {};
+    if (counts[aoc::perf::Cycles] > 0 && counts[aoc::perf::Instructions] >= 0)
+        rates.ipc = static_cast<double>(counts[aoc::perf::Instructions]) / counts[aoc::perf::Cycles];
+    for (size_t i {0}; i < miss_events.size(); i++)
+        if (elements > 0 && counts[miss_events[i]] >= 0)
+            rates.misses_per_element[i] = static_cast<double>(counts[miss_events[i]]) / elements;
+    return rates;
+}
+
+void write_counters(aoc::JsonWriter& json, const aoc::perf::Sample& counts, long elements) {
+    for (int i {0}; i < aoc::perf::event_count; i++)
+        if (counts[i] >= 0)
+            json.field(aoc::perf::event_names[i], counts[i]);
+
+    Rates r {rates(counts, elements)};
+    if (r.ipc >= 0)
+        json.field("ipc", r.ipc);
+    for (size_t i {0}; i < miss_events.size(); i++)
+        if (r.misses_per_element[i] >= 0)
+            json.field(std::string {aoc::perf::event_names[miss_events[i]]} + "_per_element", r.misses_per_element[i]);
+}
+
+void write_json(const Options& options, const std::vector<SolverStats>& all_stats, const std::string& perf_error) {
+    std::ofstream out {options.json_path};
+    aoc::JsonWriter json {out};
+
+    json.begin_object().newline();
+    json.field("commit", git_commit(options.source_dir)).newline();
+    json.field("timestamp", iso_timestamp()).newline();
+    json.field("runs", options.runs).newline();
+    json.field("warmup", options.warmup).newline();
+    if (options.perf || !perf_error.empty()) {
+        json.key("perf").begin_object().field("available", perf_error.empty());
+        if (!perf_error.empty())
+            json.field("reason", perf_error);
+        json.end_object().newline();
+    }
+    json.key("results").begin_array().newline();
+
+    for (const SolverStats& stats : all_stats) {
+        std::vector<double> sorted {stats.wall_ms};
+        std::sort(sorted.begin(), sorted.end());
+
+        json.begin_object();
+        json.field("name", stats.name);
+        json.field("input", stats.input.string());
+        json.field("failures", stats.failures);
+        json.key("wall_ms").begin_object()
+            .field("min", sorted.empty() ? 0.0 : sorted.front())
+            .field("median", median(sorted))
+            .field("p99", percentile(sorted, 99))
+            .field("max", sorted.empty() ? 0.0 : sorted.back())
+            .end_object();
+        json.field("peak_rss_kb", stats.peak_rss_kb);
+        json.field("output", stats.output);
+        if (stats.counted) {
+            json.key("perf").begin_object();
+            json.field("elements", stats.elements).field("element_unit", stats.element_unit);
+            json.key("total").begin_object();
+            write_counters(json, stats.counted->total, stats.elements);
+            json.end_object();
+            json.key("phases").begin_array();
+            for (const PhaseCounters& phase : stats.counted->phases) {
+                json.begin_object().field("name", phase.name);
+                write_counters(json, phase.counts, stats.elements);
+                json.end_object();
+            }
+            json.end_array();
+            json.end_object();
+        }
+        json.end_object().newline();
+    }
+
+    json.end_array().newline();
+    json.end_object().newline();
+}
+
+std::string format_count(long count) {
+    return count < 0 ? "-" : std::to_string(count);
+}
+
+std::string format_rate(double rate) {
+    if (rate < 0)
+        return "-";
+    std::ostringstream out {};
+    out << std::fixed << std::setprecision(rate < 10 ? 3 : 1) << rate;
+    return out.str();
+}
+
+void print_counter_row(std::string_view name, std::string_view phase, const aoc::perf::Sample& counts,
+                       long elements, std::string_view note) {
+    Rates r {rates(counts, elements)};
+    std::cout << std::left << std::setw(10) << name << std::setw(10) << phase << std::right
+              << std::setw(15) << format_count(counts[aoc::perf::Cycles])
+              << std::setw(15) << format_count(counts[aoc::perf::Instructions])
+              << std::setw(7) << format_rate(r.ipc);
+    for (double misses : r.misses_per_element)
+        std::cout << std::setw(12) << format_rate(misses);
+    if (!note.empty())
+        std::cout << "  " << note;
+    std::cout << '\n';
+}
+
+void print_counters(const std::vector<SolverStats>& all_stats) {
+    std::cout << "\nHardware counters, one run per solver; misses are per input element\n"
+              << std::left << std::setw(10) << "solver" << std::setw(10) << "phase" << std::right
+              << std::setw(15) << "cycles"
+              << std::setw(15) << "instructions"
+              << std::setw(7) << "IPC"
+              << std::setw(12) << "L1D miss"
+              << std::setw(12) << "LLC miss"
+              << std::setw(12) << "br miss"
+              << "  elements\n";
+
+    for (const SolverStats& stats : all_stats) {
+        if (!stats.counted)
+            continue;
+        std::string elements {std::to_string(stats.elements) + ' ' + stats.element_unit};
+        print_counter_row(stats.name, "total", stats.counted->total, stats.elements, elements);
+        for (const PhaseCounters& phase : stats.counted->phases)
+            print_counter_row("", phase.name, phase.counts, stats.elements, "");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options {};
+    try {
+        options = parse_options(argc, argv);
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << "aoc_bench: " << e.what() << '\n';
+        return 2;
+    }
+
+    fs::path capture {fs::temp_directory_path() / ("aoc_bench_" + std::to_string(getpid()) + ".out")};
+    fs::path trace {fs::temp_directory_path() / ("aoc_bench_" + std::to_string(getpid()) + ".trace.json")};
+    std::vector<SolverStats> all_stats {};
+
+    /* Counters that cannot be opened here will not open for a child either. */
+    std::string perf_error {};
+    if (options.perf) {
+        aoc::perf::Counters probe {};
+        if (!probe.available()) {
+            perf_error = probe.error();
+            options.perf = false;
+            std::cout << "Hardware counters unavailable, timing only: " << perf_error << "\n\n";
+        }
+    }
+
+    std::cout << std::left << std::setw(10) << "solver"
+              << std::right << std::setw(12) << "min ms"
+              << std::setw(12) << "median ms"
+              << std::setw(12) << "p99 ms"
+              << std::setw(12) << "peak RSS"
+              << "  answer\n";
+
+    for (int day : options.days) {
+        for (int part : options.parts) {
+            std::string name {aoc::day_name(day, part)};
+            fs::path binary {options.bin_dir / name / "solution"};
+            fs::path input {fs::absolute(options.source_dir / name / options.input_name)};
+            if (!fs::exists(binary) || !fs::exists(input))
+                continue;
+
+            SolverStats stats {};
+            stats.name = name;
+            stats.input = input;
+
+            for (int i {0}; i < options.warmup; i++)
+                run_once(binary, input, std::nullopt);
+
+            for (int i {0}; i < options.runs; i++) {
+                bool first {i == 0};
+                RunResult result {run_once(binary, input, first ? std::optional {capture} : std::nullopt)};
+
+                if (result.exit_status != 0)
+                    stats.failures++;
+                stats.wall_ms.push_back(result.wall_ms);
+                stats.peak_rss_kb = std::max(stats.peak_rss_kb, result.max_rss_kb);
+
+                if (first)
+                    stats.output = read_file(capture);
+            }
+
+            if (options.perf) {
+                auto [elements, unit] = count_elements(read_file(input), day);
+                stats.elements = elements;
+                stats.element_unit = unit;
+                stats.counted = run_counted(binary, input, trace);
+            }
+
+            std::vector<double> sorted {stats.wall_ms};
+            std::sort(sorted.begin(), sorted.end());
+
+            /* The last line of output is (almost always) the answer. */
+            std::string answer {stats.output};
+            while (!answer.empty() && answer.back() == '\n')
+                answer.pop_back();
+            answer = answer.substr(answer.find_last_of('\n') + 1);
+
+            std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(3)
+                      << std::setw(12) << sorted.front()
+                      << std::setw(12) << median(sorted)
+                      << std::setw(12) << percentile(sorted, 99)
+                      << std::setw(9) << stats.peak_rss_kb / 1024.0 << " MB"
+                      << "  " << (stats.failures > 0 ? "FAILED" : answer) << '\n';
+
+            all_stats.push_back(stats);
+        }
+    }
+
+    fs::remove(capture);
+    if (options.perf)
+        print_counters(all_stats);
+    write_json(options, all_stats, perf_error);
+    std::cout << "Wrote " << options.json_path.string() << '\n';
+
+    return 0;
+}
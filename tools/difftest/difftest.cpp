@@ -0,0 +1,316 @@
+
+/* aoc_difftest: differential testing of a candidate solver against a
+ * reference one.
+ *
+ * Both are shell commands that read a puzzle input on stdin. For each run a
+ * small random input is generated (see tools/gen), both commands solve it, and
+ * their stdout must match byte for byte. Inputs the reference itself fails on
+ * (crash, timeout) are skipped, since there is nothing to compare against.
+ *
+ * The first divergent input is shrunk by delta debugging over its lines,
+ * keeping only changes that still make the two disagree while the reference
+ * still succeeds, and is then saved for replaying by hand. */
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../../common/cli.hpp"
+#include "../gen/generators.hpp"
+
+namespace fs = std::filesystem;
+
+struct Options {
+    int day {0};
+    int part {1};
+    std::string reference {};
+    std::string candidate {};
+    std::string engine {};
+    long runs {1000};
+    long seed {1};
+    long max_size {-1};
+    int timeout_s {10};
+    fs::path save {};
+};
+
+struct Outcome {
+    bool ok {false};        // Exited with status 0 in time.
+    std::string output {};
+    std::string status {};  // Human readable, for reports.
+};
+
+fs::path work_dir {};
+
+/* Runs `sh -c "exec command"` with input as stdin. The command execs in place
+ * of the shell, so the alarm set here kills the solver itself on timeout. */
+Outcome run_command(const std::string& command, const fs::path& input, int timeout_s) {
+    fs::path capture {work_dir / "output"};
+
+    pid_t pid {fork()};
+    if (pid < 0) {
+        perror("fork");
+        std::exit(1);
+    }
+
+    if (pid == 0) {
+        int in_fd {open(input.c_str(), O_RDONLY)};
+        int out_fd {open(capture.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+        int null_fd {open("/dev/null", O_WRONLY)};
+        if (in_fd < 0 || out_fd < 0 || null_fd < 0)
+            _exit(127);
+
+        dup2(in_fd, STDIN_FILENO);
+        dup2(out_fd, STDOUT_FILENO);
+        dup2(null_fd, STDERR_FILENO);
+
+        alarm(timeout_s);
+        std::string shell_command {"exec " + command};
+        execl("/bin/sh", "sh", "-c", shell_command.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    int status {};
+    waitpid(pid, &status, 0);
+
+    Outcome outcome {};
+    std::ifstream in {capture, std::ios::binary};
+    std::ostringstream contents {};
+    contents << in.rdbuf();
+    outcome.output = contents.str();
+
+    if (WIFEXITED(status)) {
+        outcome.ok = WEXITSTATUS(status) == 0;
+        outcome.status = "exit status " + std::to_string(WEXITSTATUS(status));
+    }
+    else if (WTERMSIG(status) == SIGALRM)
+        outcome.status = "timed out after " + std::to_string(timeout_s) + "s";
+    else
+        outcome.status = "killed by signal " + std::to_string(WTERMSIG(status)) + " (" + strsignal(WTERMSIG(status)) + ")";
+
+    return outcome;
+}
+
+void write_file(const fs::path& path, std::string_view contents) {
+    std::ofstream out {path, std::ios::binary};
+    out << contents;
+}
+
+enum class Verdict {
+    Agree,
+    Reference_Failed,
+    Diverge,
+};
+
+struct Comparison {
+    Verdict verdict {};
+    std::string input {};
+    Outcome reference {};
+    Outcome candidate {};
+};
+
+/* The candidate diverges if it fails or disagrees where the reference works. */
+Comparison compare(const Options& options, const std::string& input) {
+    fs::path path {work_dir / "input.txt"};
+    write_file(path, input);
+
+    Comparison comparison {};
+    comparison.input = input;
+    comparison.reference = run_command(options.reference, path, options.timeout_s);
+    if (!comparison.reference.ok) {
+        comparison.verdict = Verdict::Reference_Failed;
+        return comparison;
+    }
+
+    comparison.candidate = run_command(options.candidate, path, options.timeout_s);
+    bool agree {comparison.candidate.ok && comparison.candidate.output == comparison.reference.output};
+    comparison.verdict = agree ? Verdict::Agree : Verdict::Diverge;
+    return comparison;
+}
+
+std::string join_lines(const std::vector<std::string>& lines) {
+    std::string text {};
+    for (const std::string& line : lines)
+        text += line + '\n';
+    return text;
+}
+
+/* ddmin over lines: repeatedly try deleting one of n chunks, refining the
+ * chunks when nothing can be deleted, until single lines are all needed. */
+Comparison minimize(const Options& options, Comparison divergence) {
+    std::vector<std::string> lines {};
+    std::istringstream in {divergence.input};
+    for (std::string line {}; std::getline(in, line); )
+        lines.push_back(line);
+
+    size_t n {2};
+    while (lines.size() >= 2) {
+        size_t chunk {(lines.size() + n - 1) / n};
+        bool reduced {false};
+
+        for (size_t start {0}; start < lines.size(); start += chunk) {
+            std::vector<std::string> complement {lines.begin(), lines.begin() + start};
+            complement.insert(complement.end(), lines.begin() + std::min(start + chunk, lines.size()), lines.end());
+
+            Comparison smaller {compare(options, join_lines(complement))};
+            if (smaller.verdict == Verdict::Diverge) {
+                lines = std::move(complement);
+                divergence = std::move(smaller);
+                n = std::max<size_t>(n - 1, 2);
+                reduced = true;
+                break;
+            }
+        }
+
+        if (!reduced) {
+            if (n >= lines.size())
+                break;
+            n = std::min(lines.size(), n * 2);
+        }
+    }
+
+    return divergence;
+}
+
+void print_usage() {
+    std::cerr << "usage: aoc_difftest --day=N [--part=1|2] (--candidate=CMD | --engine=NAME)\n"
+                 "                    [--reference=CMD] [--runs=1000] [--seed=1] [--max-size=N]\n"
+                 "                    [--timeout=10] [--save=FILE]\n"
+                 "CMD is run through sh and reads the input on stdin. The reference defaults\n"
+                 "to this build's DayNN-P/solution; --engine=NAME is short for a candidate of\n"
+                 "that same program run with --engine=NAME.\n";
+}
+
+Options parse_options(int argc, char* argv[]) {
+    Options options {};
+
+    for (int i {1}; i < argc; i++) {
+        std::string_view arg {argv[i]};
+
+        if (auto v {aoc::option_value(arg, "day")})
+            options.day = static_cast<int>(aoc::parse_long(*v));
+        else if (auto v {aoc::option_value(arg, "part")})
+            options.part = static_cast<int>(aoc::parse_long(*v));
+        else if (auto v {aoc::option_value(arg, "reference")})
+            options.reference = *v;
+        else if (auto v {aoc::option_value(arg, "candidate")})
+            options.candidate = *v;
+        else if (auto v {aoc::option_value(arg, "engine")})
+            options.engine = *v;
+        else if (auto v {aoc::option_value(arg, "runs")})
+            options.runs = std::max(1L, aoc::parse_long(*v));
+        else if (auto v {aoc::option_value(arg, "seed")})
+            options.seed = aoc::parse_long(*v);
+        else if (auto v {aoc::option_value(arg, "max-size")})
+            options.max_size = std::max(1L, aoc::parse_long(*v));
+        else if (auto v {aoc::option_value(arg, "timeout")})
+            options.timeout_s = static_cast<int>(std::max(1L, aoc::parse_long(*v)));
+        else if (auto v {aoc::option_value(arg, "save")})
+            options.save = *v;
+        else {
+            print_usage();
+            std::exit(arg == "--help" ? 0 : 2);
+        }
+    }
+
+    if (options.day == 0 || options.candidate.empty() == options.engine.empty()) {
+        print_usage();
+        std::exit(2);
+    }
+
+    std::string name {aoc::day_name(options.day, options.part)};
+    if (!options.engine.empty())
+        options.candidate = (fs::path {AOC_BINARY_DIR} / name / "solution").string() + " --engine=" + options.engine;
+    if (options.reference.empty())
+        options.reference = (fs::path {AOC_BINARY_DIR} / name / "solution").string();
+    if (options.save.empty())
+        options.save = "difftest-" + name + ".txt";
+
+    return options;
+}
+
+void print_output(std::string_view label, const Outcome& outcome) {
+    std::cout << label << " (" << outcome.status << "):\n" << outcome.output;
+    if (!outcome.output.empty() && outcome.output.back() != '\n')
+        std::cout << '\n';
+}
+
+int main(int argc, char* argv[]) {
+    Options options {};
+    try {
+        options = parse_options(argc, argv);
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << "aoc_difftest: " << e.what() << '\n';
+        return 2;
+    }
+
+    const aoc::gen::GeneratorInfo* info {aoc::gen::find_generator(options.day)};
+    if (info == nullptr) {
+        std::cerr << "aoc_difftest: no generator for day " << options.day << '\n';
+        return 2;
+    }
+    long max_size {options.max_size > 0 ? options.max_size : std::max(1L, info->small_size)};
+
+    work_dir = fs::temp_directory_path() / ("aoc_difftest_" + std::to_string(getpid()));
+    fs::create_directories(work_dir);
+
+    std::string name {aoc::day_name(options.day, options.part)};
+    aoc::gen::Rng sizes {static_cast<uint64_t>(options.seed)};
+    long skipped {0};
+
+    for (long run {0}; run < options.runs; run++) {
+        long seed {options.seed + run};
+        long size {sizes.uniform(1, max_size)};
+
+        char* buffer {nullptr};
+        size_t length {0};
+        FILE* out {open_memstream(&buffer, &length)};
+        aoc::gen::generate(options.day, size, static_cast<uint64_t>(seed), options.part, out);
+        std::fclose(out);
+        std::string input {buffer, length};
+        std::free(buffer);
+
+        Comparison comparison {compare(options, input)};
+        if (comparison.verdict == Verdict::Reference_Failed)
+            skipped++;
+        if (comparison.verdict != Verdict::Diverge)
+            continue;
+
+        std::cout << name << ": divergence on run " << run + 1 << " (reproduce with aoc_gen --day="
+                  << options.day << " --part=" << options.part << " --size=" << size
+                  << " --seed=" << seed << ")\n";
+
+        size_t original_size {input.size()};
+        Comparison minimal {minimize(options, std::move(comparison))};
+        write_file(options.save, minimal.input);
+
+        std::cout << "Minimized from " << original_size << " to " << minimal.input.size()
+                  << " bytes, saved to " << options.save.string() << ":\n"
+                  << minimal.input;
+        print_output("reference", minimal.reference);
+        print_output("candidate", minimal.candidate);
+
+        fs::remove_all(work_dir);
+        return 1;
+    }
+
+    std::cout << name << ": " << options.runs - skipped << " inputs agreed";
+    if (skipped > 0)
+        std::cout << ", " << skipped << " skipped because the reference failed on them";
+    std::cout << '\n';
+
+    fs::remove_all(work_dir);
+    return 0;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+/* aoc's on-disk answer cache (--cache=DIR).
+ *
+ * An answer is stored under everything it depends on: day, part, engine, the
+ * solver's version (a hash of its source, see CMakeLists.txt) and the SHA-256
+ * of the input bytes. A change to any of those is a miss, so entries never
+ * need invalidating; stale ones are simply never looked up again.
+ *
+ * Each entry is a small JSON file named after its key, written to a temporary
+ * name and renamed into place, so concurrent jobs (or concurrent runs) never
+ * see half an entry. */
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+
+#include <unistd.h>
+
+#include "../../common/cli.hpp"
+#include "../../common/json.hpp"
+
+namespace fs = std::filesystem;
+
+struct CacheKey {
+    int day {};
+    int part {};
+    std::string engine {};
+    std::string version {};
+    std::string input_hash {};
+};
+
+struct CacheEntry {
+    std::string answer {};
+    double solve_ms {};
+};
+
+class AnswerCache {
+private:
+    fs::path dir;
+
+    fs::path entry_path(const CacheKey& key) const {
+        return dir / (aoc::day_name(key.day, key.part) + '.' + key.engine + '.' + key.version + '.' + key.input_hash + ".json");
+    }
+
+public:
+    explicit AnswerCache(fs::path dir) : dir {std::move(dir)} {
+        fs::create_directories(this->dir);
+    }
+
+    std::optional<CacheEntry> lookup(const CacheKey& key) const {
+        std::ifstream in {entry_path(key), std::ios::binary};
+        if (!in)
+            return std::nullopt;
+        std::ostringstream contents {};
+        contents << in.rdbuf();
+        std::string text {contents.str()};
+
+        try {
+            aoc::JsonValue entry {aoc::JsonReader {text}.parse()};
+            const aoc::JsonValue* answer {entry.find("answer")};
+            const aoc::JsonValue* solve_ms {entry.find("solve_ms")};
+            const aoc::JsonValue* input {entry.find("input")};
+            if (answer == nullptr || solve_ms == nullptr || input == nullptr || input->string != key.input_hash)
+                return std::nullopt;
+            return CacheEntry {answer->string, solve_ms->number};
+        }
+        catch (const std::invalid_argument&) {
+            return std::nullopt; // Treated as a miss, and overwritten.
+        }
+    }
+
+    void store(const CacheKey& key, const CacheEntry& entry) const {
+        fs::path path {entry_path(key)};
+        fs::path temporary {path};
+        temporary += ".tmp" + std::to_string(getpid()); // One job per key in a run, so this is unique.
+
+        {
+            std::ofstream out {temporary};
+            aoc::JsonWriter json {out};
+            json.begin_object()
+                .field("day", key.day).field("part", key.part)
+                .field("engine", key.engine).field("version", key.version)
+                .field("input", key.input_hash)
+                .field("answer", entry.answer).field("solve_ms", entry.solve_ms)
+                .end_object().newline();
+        }
+
+        std::error_code ec {};
+        fs::rename(temporary, path, ec);
+        if (ec)
+            fs::remove(temporary, ec);
+    }
+};
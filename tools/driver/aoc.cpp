@@ -0,0 +1,258 @@
+
+/* aoc: every solver in one program, running several days at once.
+ *
+ *     ./build/aoc --days=1-25 --parts=1,2 --jobs=8
+ *
+ * Each selected day and part is a job on a thread pool. Jobs are started
+ * longest first, using the times recorded by earlier runs, so the slow days
+ * are not left until the end; a whole run then takes about as long as the
+ * slowest day. Jobs with no recorded time go first, since they may be slow.
+ *
+ * With --cache=DIR, answers are kept on disk (see answer_cache.hpp) and an
+ * input seen before is answered without solving it. --cache-verify=F solves
+ * that fraction of the cached jobs anyway, chosen at random, and reports any
+ * whose cached answer was wrong. */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <optional>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../common/cli.hpp"
+#include "../../common/input.hpp"
+#include "../../common/json.hpp"
+#include "../../common/run.hpp"
+#include "../../common/sha256.hpp"
+#include "../../common/solver.hpp"
+#include "../../common/thread_pool.hpp"
+#include "answer_cache.hpp"
+
+namespace fs = std::filesystem;
+
+struct Options {
+    fs::path source_dir {AOC_SOURCE_DIR};
+    std::string input_name {"input.txt"};
+    fs::path timings_path {fs::path {AOC_BINARY_DIR} / "aoc_timings.json"};
+    std::string engine {"reference"};
+    fs::path cache_dir {};
+    double verify_fraction {0};
+    std::set<int> days {};
+    std::set<int> parts {1, 2};
+    unsigned jobs {aoc::ThreadPool::default_threads()};
+};
+
+struct Job {
+    const aoc::Solver* solver {};
+    std::string name {};
+    fs::path input {};
+    double expected_ms {};
+    bool verify {false}; // Solve even if the answer is cached.
+
+    aoc::SolveResult result {};
+    bool solved {false}; // As opposed to answered from the cache.
+    bool stale {false};  // Verified, and the cache was wrong.
+    std::string note {};
+};
+
+/* Times are kept per engine, since engines of one day can differ wildly. */
+std::string timing_key(const Job& job) {
+    if (std::string_view {job.solver->engine} == "reference")
+        return job.name;
+    return job.name + ':' + job.solver->engine;
+}
+
+std::map<std::string, double> read_timings(const fs::path& path) {
+    std::map<std::string, double> timings {};
+
+    std::ifstream in {path, std::ios::binary};
+    if (!in)
+        return timings;
+    std::ostringstream contents {};
+    contents << in.rdbuf();
+    std::string text {contents.str()};
+
+    try {
+        aoc::JsonValue document {aoc::JsonReader {text}.parse()};
+        for (size_t i {0}; i < document.keys.size(); i++)
+            timings[document.keys[i]] = document.items[i].number;
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << "aoc: ignoring " << path.string() << ": " << e.what() << '\n';
+    }
+    return timings;
+}
+
+void write_timings(const fs::path& path, const std::map<std::string, double>& timings) {
+    std::ofstream out {path};
+    aoc::JsonWriter json {out};
+    json.begin_object().newline();
+    for (const auto& [key, ms] : timings)
+        json.field(key, ms).newline();
+    json.end_object().newline();
+}
+
+void run_job(Job& job, const AnswerCache* cache) {
+    if (cache == nullptr) {
+        job.result = aoc::solve_file(*job.solver, job.input.string());
+        job.solved = true;
+        return;
+    }
+
+    auto start {std::chrono::steady_clock::now()};
+    try {
+        aoc::InputFile input {aoc::InputFile::open(job.input.string())};
+        CacheKey key {job.solver->day, job.solver->part, job.solver->engine, job.solver->version, aoc::sha256(input.text())};
+
+        std::optional<CacheEntry> entry {cache->lookup(key)};
+        if (entry && !job.verify) {
+            job.result = {true, entry->answer, aoc::ms_since(start)};
+            std::ostringstream note {};
+            note << std::fixed << std::setprecision(3) << "cached, solved in " << entry->solve_ms << " ms";
+            job.note = note.str();
+            return;
+        }
+
+        job.result = aoc::solve_text(*job.solver, input.text());
+        job.solved = true;
+        if (job.result.ok)
+            cache->store(key, {job.result.answer, job.result.ms});
+
+        if (entry && job.result.ok && entry->answer != job.result.answer) {
+            job.note = "STALE: the cache said " + entry->answer + ", now corrected";
+            job.stale = true;
+        }
+        else if (entry)
+            job.note = "cache verified";
+    }
+    catch (const std::exception& e) {
+        job.result = {false, e.what(), aoc::ms_since(start)};
+    }
+}
+
+void print_usage() {
+    std::cerr << "usage: aoc [--days=1-25] [--parts=1,2] [--jobs=N] [--engine=reference]\n"
+                 "           [--input=input.txt] [--source-dir=DIR] [--timings=FILE]\n"
+                 "           [--cache=DIR [--cache-verify=FRACTION]]\n";
+}
+
+Options parse_options(int argc, char* argv[]) {
+    Options options {};
+    for (int i {1}; i <= 25; i++)
+        options.days.insert(i);
+
+    for (int i {1}; i < argc; i++) {
+        std::string_view arg {argv[i]};
+
+        if (auto v {aoc::option_value(arg, "days")})
+            options.days = aoc::parse_number_set(*v);
+        else if (auto v {aoc::option_value(arg, "parts")})
+            options.parts = aoc::parse_number_set(*v);
+        else if (auto v {aoc::option_value(arg, "jobs")})
+            options.jobs = static_cast<unsigned>(std::max(1L, aoc::parse_long(*v)));
+        else if (auto v {aoc::option_value(arg, "engine")})
+            options.engine = *v;
+        else if (auto v {aoc::option_value(arg, "input")})
+            options.input_name = *v;
+        else if (auto v {aoc::option_value(arg, "source-dir")})
+            options.source_dir = *v;
+        else if (auto v {aoc::option_value(arg, "timings")})
+            options.timings_path = *v;
+        else if (auto v {aoc::option_value(arg, "cache")})
+            options.cache_dir = *v;
+        else if (auto v {aoc::option_value(arg, "cache-verify")})
+            options.verify_fraction = std::clamp(aoc::parse_double(*v), 0.0, 1.0);
+        else {
+            print_usage();
+            std::exit(arg == "--help" ? 0 : 2);
+        }
+    }
+
+    return options;
+}
+
+int main(int argc, char* argv[]) {
+    Options options {};
+    try {
+        options = parse_options(argc, argv);
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << "aoc: " << e.what() << '\n';
+        return 2;
+    }
+
+    std::map<std::string, double> timings {read_timings(options.timings_path)};
+
+    std::optional<AnswerCache> cache {};
+    if (!options.cache_dir.empty())
+        cache.emplace(options.cache_dir);
+    std::mt19937_64 random {std::random_device {}()};
+    std::uniform_real_distribution<double> sample {0, 1};
+
+    /* Kept in day order for printing; started in a different order. */
+    std::vector<Job> jobs {};
+    for (const aoc::Solver& solver : aoc::solvers()) {
+        if (!options.days.contains(solver.day) || !options.parts.contains(solver.part) || solver.engine != options.engine)
+            continue;
+
+        Job job {};
+        job.solver = &solver;
+        job.name = aoc::day_name(solver.day, solver.part);
+        job.input = options.source_dir / job.name / options.input_name;
+        if (!fs::exists(job.input))
+            continue;
+
+        auto recorded {timings.find(timing_key(job))};
+        job.expected_ms = recorded != timings.end() ? recorded->second : INFINITY;
+        job.verify = sample(random) < options.verify_fraction;
+        jobs.push_back(job);
+    }
+
+    if (jobs.empty()) {
+        std::cerr << "aoc: nothing to run\n";
+        return 2;
+    }
+
+    std::vector<Job*> schedule {};
+    for (Job& job : jobs)
+        schedule.push_back(&job);
+    std::stable_sort(schedule.begin(), schedule.end(), [](const Job* a, const Job* b) {
+        return a->expected_ms > b->expected_ms;
+    });
+
+    auto start {std::chrono::steady_clock::now()};
+    {
+        aoc::ThreadPool pool {std::min<unsigned>(options.jobs, jobs.size())};
+        for (Job* job : schedule)
+            pool.submit([job, &cache] { run_job(*job, cache ? &*cache : nullptr); });
+        pool.wait();
+    }
+    auto end {std::chrono::steady_clock::now()};
+
+    int failures {0};
+    double total_ms {0};
+    for (const Job& job : jobs) {
+        aoc::print_result(std::cout, job.name, 10, job.result, job.note);
+
+        failures += !job.result.ok || job.stale;
+        total_ms += job.result.ms;
+        if (job.result.ok && job.solved)
+            timings[timing_key(job)] = job.result.ms;
+    }
+
+    double wall_ms {std::chrono::duration<double, std::milli>(end - start).count()};
+    std::cout << jobs.size() << " solvers in " << wall_ms << " ms on " << std::min<size_t>(options.jobs, jobs.size())
+              << " threads (" << total_ms << " ms if run one after another)\n";
+
+    write_timings(options.timings_path, timings);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,90 @@
+
+/* aoc_gen: writes a synthetic puzzle input for one day to stdout (or a file),
+ * in exactly the format that day's solver reads:
+ *
+ *     aoc_gen --day=5 --size=2000000 --seed=7 > lines.txt
+ *     ./build/Day05-2/solution lines.txt
+ *
+ * The meaning of size depends on the day; --list shows it for every day. */
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "../../common/cli.hpp"
+#include "generators.hpp"
+
+void print_usage() {
+    std::cerr << "usage: aoc_gen --day=N [--size=N] [--seed=N] [--part=1|2] [--output=FILE]\n"
+                 "       aoc_gen --list\n";
+}
+
+void print_list() {
+    for (int day {1}; day <= 25; day++) {
+        const aoc::gen::GeneratorInfo* info {aoc::gen::find_generator(day)};
+        if (info == nullptr)
+            continue;
+        std::cout << "day " << day << ": size = " << info->size_meaning
+                  << " (default " << info->default_size << ", small " << info->small_size << ")\n";
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int day {0};
+    long size {-1};
+    long seed {1};
+    int part {1};
+    std::string output {};
+
+    try {
+        for (int i {1}; i < argc; i++) {
+            std::string_view arg {argv[i]};
+
+            if (auto v {aoc::option_value(arg, "day")})
+                day = static_cast<int>(aoc::parse_long(*v));
+            else if (auto v {aoc::option_value(arg, "size")})
+                size = aoc::parse_long(*v);
+            else if (auto v {aoc::option_value(arg, "seed")})
+                seed = aoc::parse_long(*v);
+            else if (auto v {aoc::option_value(arg, "part")})
+                part = static_cast<int>(aoc::parse_long(*v));
+            else if (auto v {aoc::option_value(arg, "output")})
+                output = *v;
+            else if (arg == "--list") {
+                print_list();
+                return 0;
+            }
+            else {
+                print_usage();
+                return arg == "--help" ? 0 : 2;
+            }
+        }
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << "aoc_gen: " << e.what() << '\n';
+        return 2;
+    }
+
+    const aoc::gen::GeneratorInfo* info {aoc::gen::find_generator(day)};
+    if (info == nullptr) {
+        print_usage();
+        return 2;
+    }
+    if (size < 0)
+        size = info->default_size;
+
+    FILE* out {stdout};
+    if (!output.empty()) {
+        out = std::fopen(output.c_str(), "w");
+        if (out == nullptr) {
+            std::perror(output.c_str());
+            return 1;
+        }
+    }
+
+    aoc::gen::generate(day, size, static_cast<uint64_t>(seed), part, out);
+
+    if (out != stdout)
+        std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,805 @@
+#include "generators.hpp"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace aoc::gen {
+
+namespace {
+
+/* The first n elements of a random permutation of 0 .. count - 1. */
+std::vector<int> sample_distinct(Rng& rng, int count, int n) {
+    std::vector<int> values(count);
+    std::iota(values.begin(), values.end(), 0);
+    for (int i {0}; i < n && i < count; i++)
+        std::swap(values[i], values[rng.uniform(i, count - 1)]);
+    values.resize(std::min(n, count));
+    return values;
+}
+
+template<typename T>
+void shuffle(Rng& rng, std::vector<T>& values) {
+    for (long i {static_cast<long>(values.size()) - 1}; i > 0; i--)
+        std::swap(values[i], values[rng.uniform(0, i)]);
+}
+
+/* Any grid of single characters, one row per line. */
+template<typename CellFn>
+void put_grid(Writer& out, long rows, long cols, CellFn cell) {
+    for (long r {0}; r < rows; r++) {
+        for (long c {0}; c < cols; c++)
+            out.put(cell());
+        out.put('\n');
+    }
+}
+
+/* Sonar depths: a noisy walk that mostly goes deeper. */
+void day01(Writer& out, long size, Rng& rng, int) {
+    long depth {rng.uniform(100, 200)};
+    for (long i {0}; i < size; i++) {
+        out.put(depth).put('\n');
+        depth = std::max(0L, depth + rng.uniform(-15, 25));
+    }
+}
+
+void day02(Writer& out, long size, Rng& rng, int) {
+    long depth {0};
+    for (long i {0}; i < size; i++) {
+        long amount {rng.uniform(1, 9)};
+        if (rng.chance(0.5))
+            out.put("forward ");
+        else if (depth < amount || rng.chance(0.6)) {
+            out.put("down ");
+            depth += amount;
+        }
+        else {
+            out.put("up ");
+            depth -= amount;
+        }
+        out.put(amount).put('\n');
+    }
+}
+
+/* The life support search narrows down to a single line, which only works if
+ * the lines are distinct, so there are at most 2^12 of them. */
+void day03(Writer& out, long size, Rng& rng, int) {
+    for (int value : sample_distinct(rng, 1 << 12, static_cast<int>(std::min(size, 1L << 12)))) {
+        for (int bit {11}; bit >= 0; bit--)
+            out.put((value >> bit) & 1 ? '1' : '0');
+        out.put('\n');
+    }
+}
+
+/* Every number gets drawn, so every board wins eventually. */
+void day04(Writer& out, long size, Rng& rng, int) {
+    std::vector<int> draws {sample_distinct(rng, 100, 100)};
+    for (size_t i {0}; i < draws.size(); i++) {
+        if (i > 0)
+            out.put(',');
+        out.put(draws[i]);
+    }
+    out.put('\n');
+
+    for (long board {0}; board < size; board++) {
+        out.put('\n');
+        std::vector<int> cells {sample_distinct(rng, 100, 25)};
+        for (int r {0}; r < 5; r++) {
+            for (int c {0}; c < 5; c++) {
+                int num {cells[r * 5 + c]};
+                if (c > 0)
+                    out.put(' ');
+                if (num < 10)
+                    out.put(' ');
+                out.put(num);
+            }
+            out.put('\n');
+        }
+    }
+}
+
+/* Horizontal, vertical and 45 degree lines on the puzzle's 1000x1000 floor. */
+void day05(Writer& out, long size, Rng& rng, int) {
+    constexpr long max_coord {999};
+
+    for (long i {0}; i < size; i++) {
+        long x1 {rng.uniform(0, max_coord)};
+        long y1 {rng.uniform(0, max_coord)};
+        long x2 {x1};
+        long y2 {y1};
+
+        switch (rng.uniform(0, 2)) {
+        case 0:
+            x2 = rng.uniform(0, max_coord);
+            break;
+        case 1:
+            y2 = rng.uniform(0, max_coord);
+            break;
+        default: {
+            long dx {rng.chance(0.5) ? 1 : -1};
+            long dy {rng.chance(0.5) ? 1 : -1};
+            long room_x {dx > 0 ? max_coord - x1 : x1};
+            long room_y {dy > 0 ? max_coord - y1 : y1};
+            long length {rng.uniform(0, std::min(room_x, room_y))};
+            x2 = x1 + dx * length;
+            y2 = y1 + dy * length;
+        }
+        }
+
+        out.put(x1).put(',').put(y1).put(" -> ").put(x2).put(',').put(y2).put('\n');
+    }
+}
+
+void day06(Writer& out, long size, Rng& rng, int) {
+    for (long i {0}; i < size; i++) {
+        if (i > 0)
+            out.put(',');
+        out.put(rng.uniform(1, 5));
+    }
+    out.put('\n');
+}
+
+/* Positions are kept below 2000, like the puzzle; part 2's memoized fuel cost
+ * recurses once per unit of distance. Small positions are more common. */
+void day07(Writer& out, long size, Rng& rng, int) {
+    for (long i {0}; i < size; i++) {
+        if (i > 0)
+            out.put(',');
+        out.put(rng.uniform(0, rng.uniform(0, 1999)));
+    }
+    out.put('\n');
+}
+
+/* Each entry scrambles the wires of a working display: the ten patterns in a
+ * random order, then four digits it shows. */
+void day08(Writer& out, long size, Rng& rng, int) {
+    static constexpr std::array<std::string_view, 10> digits {
+        "abcefg", "cf", "acdeg", "acdfg", "bcdf", "abdfg", "abdefg", "acf", "abcdefg", "abcdfg"
+    };
+
+    auto scramble = [&](std::string_view digit, const std::vector<int>& wiring) {
+        std::vector<char> segments {};
+        for (char segment : digit)
+            segments.push_back(static_cast<char>('a' + wiring[segment - 'a']));
+        shuffle(rng, segments);
+        return std::string(segments.begin(), segments.end());
+    };
+
+    for (long i {0}; i < size; i++) {
+        std::vector<int> wiring {sample_distinct(rng, 7, 7)};
+
+        std::vector<int> order {sample_distinct(rng, 10, 10)};
+        for (int digit : order)
+            out.put(scramble(digits[digit], wiring)).put(' ');
+
+        out.put('|');
+        for (int j {0}; j < 4; j++)
+            out.put(' ').put(scramble(digits[rng.uniform(0, 9)], wiring));
+        out.put('\n');
+    }
+}
+
+/* Walls of 9s are dense enough that basins stay small (the other cells stay
+ * below the percolation threshold), even on a 10k x 10k map. */
+void day09(Writer& out, long size, Rng& rng, int) {
+    put_grid(out, size, size, [&] {
+        return rng.chance(0.55) ? '9' : static_cast<char>('0' + rng.uniform(0, 8));
+    });
+}
+
+/* Every line is either corrupted or incomplete, never complete. The first
+ * line is always incomplete, since part 2 needs at least one. */
+void day10(Writer& out, long size, Rng& rng, int) {
+    static constexpr std::string_view openers {"([{<"};
+    static constexpr std::string_view closers {")]}>"};
+
+    for (long i {0}; i < size; i++) {
+        std::string line {};
+        std::vector<int> stack {};
+        long length {rng.uniform(10, 110)};
+
+        for (long j {0}; j < length; j++) {
+            if (stack.empty() || rng.chance(0.55)) {
+                int kind {static_cast<int>(rng.uniform(0, 3))};
+                stack.push_back(kind);
+                line += openers[kind];
+            }
+            else {
+                line += closers[stack.back()];
+                stack.pop_back();
+            }
+        }
+
+        if (stack.empty()) {
+            int kind {static_cast<int>(rng.uniform(0, 3))};
+            stack.push_back(kind);
+            line += openers[kind];
+        }
+
+        if (i > 0 && rng.chance(0.5)) {
+            int wrong {static_cast<int>((stack.back() + rng.uniform(1, 3)) % 4)};
+            line += closers[wrong];
+            for (long j {rng.uniform(0, 10)}; j > 0; j--) {
+                int kind {static_cast<int>(rng.uniform(0, 3))};
+                line += rng.chance(0.5) ? openers[kind] : closers[kind];
+            }
+        }
+
+        out.put(line).put('\n');
+    }
+}
+
+/* True if the octopuses all flash together within max_steps. Plenty of random
+ * grids settle into a cycle that never synchronizes, and part 2 would loop
+ * forever on those. */
+bool synchronizes(std::array<int, 100> energies, int max_steps) {
+    for (int step {0}; step < max_steps; step++) {
+        std::vector<int> to_flash {};
+        for (int i {0}; i < 100; i++)
+            if (++energies[i] == 10)
+                to_flash.push_back(i);
+
+        for (size_t f {0}; f < to_flash.size(); f++) {
+            int r {to_flash[f] / 10};
+            int c {to_flash[f] % 10};
+            for (int nr {std::max(0, r - 1)}; nr <= std::min(9, r + 1); nr++)
+                for (int nc {std::max(0, c - 1)}; nc <= std::min(9, c + 1); nc++)
+                    if (++energies[nr * 10 + nc] == 10)
+                        to_flash.push_back(nr * 10 + nc);
+        }
+
+        for (int& energy : energies)
+            if (energy > 9)
+                energy = 0;
+        if (to_flash.size() == 100)
+            return true;
+    }
+    return false;
+}
+
+/* The solver's grid is fixed at 10x10, so size is ignored. */
+void day11(Writer& out, long, Rng& rng, int) {
+    std::array<int, 100> energies {};
+    do {
+        for (int& energy : energies)
+            energy = static_cast<int>(rng.uniform(0, 9));
+    } while (!synchronizes(energies, 1000));
+
+    for (int i {0}; i < 100; i++) {
+        out.put(static_cast<char>('0' + energies[i]));
+        if (i % 10 == 9)
+            out.put('\n');
+    }
+}
+
+/* A connected cave system with size caves besides start and end. Two big
+ * caves are never adjacent, otherwise there would be infinitely many paths.
+ * The number of paths grows exponentially, so keep size small. */
+void day12(Writer& out, long size, Rng& rng, int) {
+    std::vector<std::string> names {"start", "end"};
+    std::vector<bool> big {false, false};
+    std::unordered_set<std::string> used {"start", "end"};
+
+    long num_big {std::max(1L, size / 4)};
+    for (long i {0}; i < size; i++) {
+        bool is_big {i < num_big};
+        std::string name {};
+        do {
+            char base {is_big ? 'A' : 'a'};
+            name = {static_cast<char>(base + rng.uniform(0, 25)), static_cast<char>(base + rng.uniform(0, 25))};
+        } while (used.contains(name));
+        used.insert(name);
+        names.push_back(name);
+        big.push_back(is_big);
+    }
+
+    int n {static_cast<int>(names.size())};
+    std::vector<int> order {sample_distinct(rng, n, n)};
+    std::swap(order[0], *std::find(order.begin(), order.end(), 0)); // Start is small.
+    std::unordered_set<long> edges {};
+    std::vector<std::pair<int, int>> edge_list {};
+
+    auto try_add = [&](int a, int b) {
+        if (a == b || (big[a] && big[b]) || edges.contains(static_cast<long>(std::min(a, b)) * n + std::max(a, b)))
+            return false;
+        edges.insert(static_cast<long>(std::min(a, b)) * n + std::max(a, b));
+        edge_list.push_back(rng.chance(0.5) ? std::pair {a, b} : std::pair {b, a});
+        return true;
+    };
+
+    /* A random spanning tree first, so everything is reachable. Big caves
+     * hang off an earlier small cave. */
+    std::vector<int> small_so_far {order[0]};
+    for (int i {1}; i < n; i++) {
+        int a {order[i]};
+        int b {big[a] ? small_so_far[rng.uniform(0, small_so_far.size() - 1)] : order[rng.uniform(0, i - 1)]};
+        try_add(a, b);
+        if (!big[a])
+            small_so_far.push_back(a);
+    }
+
+    for (long extra {size / 2}; extra > 0; extra--)
+        try_add(static_cast<int>(rng.uniform(0, n - 1)), static_cast<int>(rng.uniform(0, n - 1)));
+
+    shuffle(rng, edge_list);
+    for (auto [a, b] : edge_list)
+        out.put(names[a]).put('-').put(names[b]).put('\n');
+}
+
+/* Built backwards from a 40x6 sheet: each unfolding doubles a dimension and
+ * mirrors some dots across the new fold line, so no dot is ever on a fold. */
+void day13(Writer& out, long size, Rng& rng, int) {
+    std::vector<long> x_folds {40};
+    std::vector<long> y_folds {6};
+    while (x_folds.size() < 5)
+        x_folds.push_back(x_folds.back() * 2 + 1);
+    while (y_folds.size() < 7)
+        y_folds.push_back(y_folds.back() * 2 + 1);
+
+    for (long i {0}; i < size; i++) {
+        long x {rng.uniform(0, x_folds.front() - 1)};
+        long y {rng.uniform(0, y_folds.front() - 1)};
+        for (long fold : x_folds)
+            if (rng.chance(0.5))
+                x = 2 * fold - x;
+        for (long fold : y_folds)
+            if (rng.chance(0.5))
+                y = 2 * fold - y;
+        out.put(x).put(',').put(y).put('\n');
+    }
+
+    out.put('\n');
+    while (!x_folds.empty() || !y_folds.empty()) {
+        if (!x_folds.empty()) {
+            out.put("fold along x=").put(x_folds.back()).put('\n');
+            x_folds.pop_back();
+        }
+        if (!y_folds.empty()) {
+            out.put("fold along y=").put(y_folds.back()).put('\n');
+            y_folds.pop_back();
+        }
+    }
+}
+
+/* A template of size elements, with a rule for every pair of elements. */
+void day14(Writer& out, long size, Rng& rng, int) {
+    static constexpr std::string_view elements {"BCFHKNOPSV"};
+    auto element = [&] { return elements[rng.uniform(0, elements.size() - 1)]; };
+
+    for (long i {0}; i < size; i++)
+        out.put(element());
+    out.put("\n\n");
+
+    for (char a : elements)
+        for (char b : elements)
+            out.put(a).put(b).put(" -> ").put(element()).put('\n');
+}
+
+void day15(Writer& out, long size, Rng& rng, int) {
+    put_grid(out, size, size, [&] { return static_cast<char>('0' + rng.uniform(1, 9)); });
+}
+
+/* A random packet tree of about size packets, encoded as bits. Products only
+ * appear in small subtrees so part 2's answer stays well inside a long. */
+void encode_packet(std::string& bits, long budget, Rng& rng) {
+    auto put_bits = [&](long value, int n) {
+        for (int i {n - 1}; i >= 0; i--)
+            bits += (value >> i) & 1 ? '1' : '0';
+    };
+
+    put_bits(rng.uniform(0, 7), 3);
+
+    if (budget <= 1) {
+        put_bits(4, 3);
+        long value {rng.uniform(0, (1L << rng.uniform(1, 12)) - 1)};
+        int groups {1};
+        while (value >> (4 * groups))
+            groups++;
+        for (int g {groups - 1}; g >= 0; g--) {
+            bits += g > 0 ? '1' : '0';
+            put_bits(value >> (4 * g), 4);
+        }
+        return;
+    }
+
+    long children {rng.uniform(1, std::min(budget - 1, 6L))};
+    long type {};
+    if (children == 2 && rng.chance(0.3))
+        type = rng.uniform(5, 7);
+    else {
+        do {
+            type = rng.uniform(0, 3);
+        } while (type == 1 && budget > 8);
+    }
+    put_bits(type, 3);
+
+    /* Split the remaining budget among the children, at least 1 each. */
+    std::vector<long> budgets(children, 1);
+    for (long spare {budget - 1 - children}; spare > 0; spare--)
+        budgets[rng.uniform(0, children - 1)]++;
+
+    std::string sub {};
+    for (long child : budgets)
+        encode_packet(sub, child, rng);
+
+    if (sub.size() < (1 << 15) && rng.chance(0.5)) {
+        bits += '0';
+        put_bits(static_cast<long>(sub.size()), 15);
+    }
+    else {
+        bits += '1';
+        put_bits(children, 11);
+    }
+    bits += sub;
+}
+
+void day16(Writer& out, long size, Rng& rng, int) {
+    std::string bits {};
+    encode_packet(bits, std::max(1L, size), rng);
+    while (bits.size() % 4 != 0)
+        bits += '0';
+
+    static constexpr std::string_view hex {"0123456789ABCDEF"};
+    for (size_t i {0}; i < bits.size(); i += 4) {
+        int nibble {0};
+        for (size_t j {i}; j < i + 4; j++)
+            nibble = nibble * 2 + (bits[j] == '1');
+        out.put(hex[nibble]);
+    }
+    out.put('\n');
+}
+
+/* Coordinates of order size. Part 1 assumes the x range contains a
+ * triangular number (some x velocity stalls inside it), so it always does. */
+void day17(Writer& out, long size, Rng& rng, int) {
+    size = std::max(size, 10L);
+
+    long k {1};
+    long goal {rng.uniform(size, 2 * size)};
+    while (k * (k + 1) / 2 < goal)
+        k++;
+    long triangle {k * (k + 1) / 2};
+
+    long x_min {std::max(1L, triangle - rng.uniform(0, size / 4))};
+    long x_max {triangle + rng.uniform(0, size / 4)};
+    long y_min {-rng.uniform(size / 2, size)};
+    long y_max {std::min(-1L, y_min + rng.uniform(size / 10, size / 2))};
+
+    out.put("target area: x=").put(x_min).put("..").put(x_max)
+       .put(", y=").put(y_min).put("..").put(y_max).put('\n');
+}
+
+/* Reduced numbers: digits only, and no pair nested inside four pairs. */
+void put_snailfish(Writer& out, int depth, Rng& rng) {
+    out.put('[');
+    for (int side {0}; side < 2; side++) {
+        if (side == 1)
+            out.put(',');
+        if (depth < 4 && rng.chance(0.6))
+            put_snailfish(out, depth + 1, rng);
+        else
+            out.put(static_cast<char>('0' + rng.uniform(0, 9)));
+    }
+    out.put(']');
+}
+
+void day18(Writer& out, long size, Rng& rng, int) {
+    for (long i {0}; i < size; i++) {
+        put_snailfish(out, 1, rng);
+        out.put('\n');
+    }
+}
+
+/* A consistent world for the scanners. Each scanner after the first is placed
+ * near a recent one, and at least 12 fresh beacons go into the overlap of
+ * their ranges, so the scanners always form a connected graph. Every scanner
+ * then reports every beacon within 1000 on each axis, in its own randomly
+ * chosen orientation. */
+void day19(Writer& out, long size, Rng& rng, int) {
+    using Point = std::array<long, 3>;
+    using Matrix = std::array<std::array<long, 3>, 3>;
+    constexpr long range {1000};
+
+    std::vector<Matrix> rotations {};
+    std::array<int, 3> perm {0, 1, 2};
+    do {
+        for (int signs {0}; signs < 8; signs++) {
+            Matrix m {};
+            for (int row {0}; row < 3; row++)
+                m[row][perm[row]] = (signs >> row) & 1 ? -1 : 1;
+            long det {m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+                      - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+                      + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0])};
+            if (det == 1)
+                rotations.push_back(m);
+        }
+    } while (std::next_permutation(perm.begin(), perm.end()));
+
+    std::vector<Point> scanners {{0, 0, 0}};
+    std::vector<Point> beacons {};
+    std::unordered_set<std::string> seen {};
+
+    auto add_beacon = [&](const Point& p) {
+        std::string key {std::to_string(p[0]) + ',' + std::to_string(p[1]) + ',' + std::to_string(p[2])};
+        if (seen.insert(key).second)
+            beacons.push_back(p);
+    };
+
+    auto random_in = [&](const Point& low, const Point& high) {
+        return Point {rng.uniform(low[0], high[0]), rng.uniform(low[1], high[1]), rng.uniform(low[2], high[2])};
+    };
+
+    for (int i {0}; i < 25; i++)
+        add_beacon(random_in({-range, -range, -range}, {range, range, range}));
+
+    for (long i {1}; i < size; i++) {
+        const Point parent {scanners[rng.uniform(std::max(0L, i - 3), i - 1)]};
+        Point pos {};
+        for (int axis {0}; axis < 3; axis++)
+            pos[axis] = parent[axis] + rng.uniform(-1200, 1200);
+        scanners.push_back(pos);
+
+        Point low {};
+        Point high {};
+        for (int axis {0}; axis < 3; axis++) {
+            low[axis] = std::max(parent[axis], pos[axis]) - range;
+            high[axis] = std::min(parent[axis], pos[axis]) + range;
+        }
+        for (int j {0}; j < 12; j++)
+            add_beacon(random_in(low, high));
+
+        for (long j {rng.uniform(0, 14)}; j > 0; j--)
+            add_beacon(random_in({pos[0] - range, pos[1] - range, pos[2] - range},
+                                 {pos[0] + range, pos[1] + range, pos[2] + range}));
+    }
+
+    /* Bucket the beacons by 2000-wide cells so each scanner only checks 8. */
+    auto cell_of = [](long coord) {
+        return coord >= 0 ? coord / (2 * range) : -((-coord + 2 * range - 1) / (2 * range));
+    };
+    auto cell_key = [](long x, long y, long z) {
+        return ((x & 0x1fffff) << 42) | ((y & 0x1fffff) << 21) | (z & 0x1fffff);
+    };
+
+    std::unordered_map<long, std::vector<int>> cells {};
+    for (size_t b {0}; b < beacons.size(); b++)
+        cells[cell_key(cell_of(beacons[b][0]), cell_of(beacons[b][1]), cell_of(beacons[b][2]))].push_back(b);
+
+    for (size_t s {0}; s < scanners.size(); s++) {
+        const Point& pos {scanners[s]};
+        const Matrix& rot {rotations[rng.uniform(0, rotations.size() - 1)]};
+
+        std::vector<Point> report {};
+        for (long cx {cell_of(pos[0] - range)}; cx <= cell_of(pos[0] + range); cx++) {
+            for (long cy {cell_of(pos[1] - range)}; cy <= cell_of(pos[1] + range); cy++) {
+                for (long cz {cell_of(pos[2] - range)}; cz <= cell_of(pos[2] + range); cz++) {
+                    auto it {cells.find(cell_key(cx, cy, cz))};
+                    if (it == cells.end())
+                        continue;
+
+                    for (int b : it->second) {
+                        Point rel {beacons[b][0] - pos[0], beacons[b][1] - pos[1], beacons[b][2] - pos[2]};
+                        if (std::abs(rel[0]) > range || std::abs(rel[1]) > range || std::abs(rel[2]) > range)
+                            continue;
+
+                        /* world = pos + rot * local, so local = rot^T * rel. */
+                        Point local {};
+                        for (int row {0}; row < 3; row++)
+                            local[row] = rot[0][row] * rel[0] + rot[1][row] * rel[1] + rot[2][row] * rel[2];
+                        report.push_back(local);
+                    }
+                }
+            }
+        }
+        shuffle(rng, report);
+
+        if (s > 0)
+            out.put('\n');
+        out.put("--- scanner ").put(static_cast<long>(s)).put(" ---\n");
+        for (const Point& p : report)
+            out.put(p[0]).put(',').put(p[1]).put(',').put(p[2]).put('\n');
+    }
+}
+
+/* If dark pixels light the infinite background, lit ones must darken it
+ * again, or the answer after an even number of steps would be infinite. */
+void day20(Writer& out, long size, Rng& rng, int) {
+    std::string algorithm(512, '.');
+    for (char& ch : algorithm)
+        ch = rng.chance(0.5) ? '#' : '.';
+    if (algorithm.front() == '#')
+        algorithm.back() = '.';
+    out.put(algorithm).put("\n\n");
+
+    put_grid(out, size, size, [&] { return rng.chance(0.5) ? '#' : '.'; });
+}
+
+/* Just two starting positions; size is ignored. */
+void day21(Writer& out, long, Rng& rng, int) {
+    out.put("Player 1 starting position: ").put(rng.uniform(1, 10)).put('\n');
+    out.put("Player 2 starting position: ").put(rng.uniform(1, 10)).put('\n');
+}
+
+/* Like the puzzle: the first steps stay inside the -50..50 initialization
+ * region, the rest are large cuboids anywhere in -100000..100000. */
+void day22(Writer& out, long size, Rng& rng, int) {
+    for (long i {0}; i < size; i++) {
+        bool init {i < 20};
+        long limit {init ? 50 : 100000};
+        long max_extent {init ? 40 : 40000};
+        long min_extent {init ? 1 : 1000};
+
+        out.put(i == 0 || rng.chance(0.5) ? "on " : "off ");
+        for (char axis : std::string_view {"xyz"}) {
+            long extent {rng.uniform(min_extent, max_extent)};
+            long low {rng.uniform(-limit, limit - extent)};
+            if (axis != 'x')
+                out.put(',');
+            out.put(axis).put('=').put(low).put("..").put(low + extent);
+        }
+        out.put('\n');
+    }
+}
+
+/* A random burrow: two rows for part 1, four for part 2. Size is ignored. */
+void day23(Writer& out, long, Rng& rng, int part) {
+    int depth {part == 2 ? 4 : 2};
+    std::vector<char> amphipods {};
+    for (char kind : std::string_view {"ABCD"})
+        for (int i {0}; i < depth; i++)
+            amphipods.push_back(kind);
+    shuffle(rng, amphipods);
+
+    out.put("#############\n#...........#\n");
+    for (int row {0}; row < depth; row++) {
+        out.put(row == 0 ? "###" : "  #");
+        for (int room {0}; room < 4; room++)
+            out.put(amphipods[row * 4 + room]).put('#');
+        out.put(row == 0 ? "##\n" : "\n");
+    }
+    out.put("  #########\n");
+}
+
+/* The MONAD shape: 14 blocks that either push a digit onto a base 26 stack in
+ * z or pop one and compare it with the current digit. Pushes and pops are
+ * matched so that the offsets always admit a valid model number. The stack
+ * never gets deeper than 4, like the puzzle's: the solver's search is
+ * exponential in that depth. Size is ignored. */
+void day24(Writer& out, long, Rng& rng, int) {
+    std::vector<long> pushed {};
+    std::vector<long> push_offsets {};
+    int pushes_left {7};
+
+    for (int block {0}; block < 14; block++) {
+        bool push {pushes_left > 0 && (pushed.empty() || (pushed.size() < 4 && rng.chance(0.5)))};
+
+        long check {};
+        long offset {rng.uniform(1, 15)};
+        if (push) {
+            check = rng.uniform(10, 16);
+            pushed.push_back(offset);
+            pushes_left--;
+        }
+        else {
+            /* Matched digits must differ by at most 8 for both to be 1..9. */
+            check = rng.uniform(-8, 8) - pushed.back();
+            pushed.pop_back();
+        }
+
+        out.put("inp w\nmul x 0\nadd x z\nmod x 26\n");
+        out.put(push ? "div z 1\n" : "div z 26\n");
+        out.put("add x ").put(check).put('\n');
+        out.put("eql x w\neql x 0\nmul y 0\nadd y 25\nmul y x\nadd y 1\nmul z y\nmul y 0\nadd y w\n");
+        out.put("add y ").put(offset).put('\n');
+        out.put("mul y x\nadd z y\n");
+    }
+}
+
+/* True if the herds stop moving within max_steps. */
+bool comes_to_rest(std::vector<std::string> grid, long max_steps) {
+    long rows {static_cast<long>(grid.size())};
+    long cols {static_cast<long>(grid[0].size())};
+
+    for (long step {0}; step < max_steps; step++) {
+        bool moved {false};
+        for (char herd : std::string_view {">v"}) {
+            std::vector<std::string> next {grid};
+            for (long r {0}; r < rows; r++) {
+                for (long c {0}; c < cols; c++) {
+                    if (grid[r][c] != herd)
+                        continue;
+                    long nr {herd == 'v' ? (r + 1) % rows : r};
+                    long nc {herd == '>' ? (c + 1) % cols : c};
+                    if (grid[nr][nc] == '.') {
+                        next[r][c] = '.';
+                        next[nr][nc] = herd;
+                        moved = true;
+                    }
+                }
+            }
+            grid = std::move(next);
+        }
+        if (!moved)
+            return true;
+    }
+    return false;
+}
+
+/* Puzzle sized and larger grids always jam, but small ones can have a herd
+ * circling forever, so those are checked (too slow to do for big grids). */
+void day25(Writer& out, long size, Rng& rng, int) {
+    if (size > 200) {
+        put_grid(out, size, size, [&] {
+            long roll {rng.uniform(0, 3)};
+            return roll == 0 ? '>' : roll == 1 ? 'v' : '.';
+        });
+        return;
+    }
+
+    size = std::max(size, 1L);
+    std::vector<std::string> grid(size, std::string(size, '.'));
+    do {
+        for (std::string& row : grid) {
+            for (char& ch : row) {
+                long roll {rng.uniform(0, 3)};
+                ch = roll == 0 ? '>' : roll == 1 ? 'v' : '.';
+            }
+        }
+    } while (!comes_to_rest(grid, 20 * size + 100));
+
+    for (const std::string& row : grid)
+        out.put(row).put('\n');
+}
+
+constexpr std::array<GeneratorInfo, 25> generators {{
+    {1, day01, 2000, 50, "depth readings"},
+    {2, day02, 1000, 50, "commands"},
+    {3, day03, 1000, 64, "report lines (at most 4096)"},
+    {4, day04, 100, 8, "boards"},
+    {5, day05, 500, 30, "vent lines"},
+    {6, day06, 300, 20, "fish"},
+    {7, day07, 1000, 30, "crabs"},
+    {8, day08, 200, 10, "display entries"},
+    {9, day09, 100, 12, "side of the height map"},
+    {10, day10, 100, 10, "lines"},
+    {11, day11, 10, 10, "ignored (the grid is always 10x10)"},
+    {12, day12, 12, 6, "caves besides start and end"},
+    {13, day13, 900, 30, "dots"},
+    {14, day14, 20, 10, "template length"},
+    {15, day15, 100, 12, "side of the risk map"},
+    {16, day16, 300, 30, "packets"},
+    {17, day17, 100, 30, "scale of the target coordinates"},
+    {18, day18, 100, 8, "snailfish numbers"},
+    {19, day19, 30, 5, "scanners"},
+    {20, day20, 100, 12, "side of the image"},
+    {21, day21, 0, 0, "ignored"},
+    {22, day22, 420, 12, "reboot steps"},
+    {23, day23, 0, 0, "ignored (part 2 gets four rows)"},
+    {24, day24, 0, 0, "ignored (always 14 digits)"},
+    {25, day25, 137, 12, "side of the sea floor"},
+}};
+
+}
+
+const GeneratorInfo* find_generator(int day) {
+    for (const GeneratorInfo& info : generators)
+        if (info.day == day)
+            return &info;
+    return nullptr;
+}
+
+void generate(int day, long size, uint64_t seed, int part, FILE* out) {
+    const GeneratorInfo* info {find_generator(day)};
+    if (info == nullptr)
+        return;
+
+    Rng rng {seed};
+    Writer writer {out};
+    info->generate(writer, size, rng, part);
+}
+
+}
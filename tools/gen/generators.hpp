@@ -0,0 +1,109 @@
+#pragma once
+
+/* Synthetic input generators, one per day. Every generator takes a size and
+ * a seed and writes text in exactly the format that day's solver parses, so
+ * the output can be fed straight into ./solution. The same (day, size, seed,
+ * part) always produces the same bytes. */
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace aoc::gen {
+
+/* xoshiro256** seeded through splitmix64. Used instead of <random> so that a
+ * seed means the same input on every standard library. */
+class Rng {
+private:
+    uint64_t state[4] {};
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    Rng(uint64_t seed) {
+        for (uint64_t& word : state) {
+            seed += 0x9e3779b97f4a7c15;
+            uint64_t z {seed};
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result {rotl(state[1] * 5, 7) * 9};
+        uint64_t t {state[1] << 17};
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    /* Uniform in [low, high] (inclusive). The modulo bias is irrelevant here. */
+    long uniform(long low, long high) {
+        return low + static_cast<long>(next() % static_cast<uint64_t>(high - low + 1));
+    }
+
+    bool chance(double p) {
+        return (next() >> 11) * 0x1.0p-53 < p;
+    }
+};
+
+/* Buffered writer over a FILE*; the big grids run to hundreds of megabytes. */
+class Writer {
+private:
+    FILE* out;
+    std::string buffer {};
+
+public:
+    Writer(FILE* out) : out {out} { buffer.reserve(1 << 20); }
+    Writer(const Writer&) = delete;
+    ~Writer() { flush(); }
+
+    void flush() {
+        std::fwrite(buffer.data(), 1, buffer.size(), out);
+        buffer.clear();
+    }
+
+    Writer& put(char ch) {
+        buffer += ch;
+        if (buffer.size() >= (1 << 20))
+            flush();
+        return *this;
+    }
+
+    Writer& put(std::string_view str) {
+        buffer += str;
+        if (buffer.size() >= (1 << 20))
+            flush();
+        return *this;
+    }
+
+    Writer& put(long num) {
+        return put(std::string_view {std::to_string(num)});
+    }
+
+    Writer& put(int num) { return put(static_cast<long>(num)); }
+};
+
+using Generator = void (*)(Writer& out, long size, Rng& rng, int part);
+
+struct GeneratorInfo {
+    int day {};
+    Generator generate {};
+    long default_size {};  // Roughly the size of the real puzzle input.
+    long small_size {};    // Small enough for the reference solver to be quick.
+    const char* size_meaning {};
+};
+
+/* nullptr if there is no generator for that day. */
+const GeneratorInfo* find_generator(int day);
+
+/* Convenience wrapper: seeds an Rng and runs the day's generator. */
+void generate(int day, long size, uint64_t seed, int part, FILE* out);
+
+}